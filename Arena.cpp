@@ -0,0 +1,63 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Arena (bump) allocator, freed all at once
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Arena.h"
+#include "Error.h"
+
+Arena::Arena() {
+  _cur  = NULL;
+  _left = _used = _reserved = 0;
+}
+
+Arena::~Arena() {
+  clear();
+}
+
+void *Arena::alloc(size_t n) {
+  char *p;
+
+  n = (n + ARENA_ALIGN-1) & ~(size_t)(ARENA_ALIGN-1);
+  if (n > _left) {
+    // Big requests get their own block, the current one is kept
+    size_t size = max(n, (size_t)ARENA_BLOCK);
+    p = (char *)malloc(size);
+    if (p==NULL) Error::msg("Out of memory (arena)");
+    _blocks.push_back(p);
+    _reserved += size;
+    if (size > n) {
+      _cur  = p + n;
+      _left = size - n;
+    }
+  } else {
+    p = _cur;
+    _cur  += n;
+    _left -= n;
+  }
+
+  _used += n;
+  return p;
+}
+
+void Arena::clear() {
+  for (int i=0; i<(int)_blocks.size(); i++)
+    free(_blocks[i]);
+  _blocks.clear();
+  _cur  = NULL;
+  _left = _used = _reserved = 0;
+}
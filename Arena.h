@@ -0,0 +1,74 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Arena (bump) allocator, freed all at once
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _ARENA_
+#define _ARENA_
+
+#include "Common.h"
+#include <new>
+
+#define ARENA_BLOCK (1<<20) // Size of each arena block (bytes)
+#define ARENA_ALIGN 8       // Alignment of every allocation
+
+// Memory is taken from large blocks and only given back when the
+// arena is cleared or destroyed
+class Arena {
+ private:
+  vector<char *> _blocks; // All blocks
+  char *_cur;             // Free space on last block
+  size_t _left;           // Bytes left on last block
+  size_t _used;           // Bytes given out
+  size_t _reserved;       // Bytes taken from the system
+
+ public:
+  Arena();
+  ~Arena();
+
+  void *alloc(size_t n);
+  void clear();
+
+  size_t used()     {return _used;}
+  size_t reserved() {return _reserved;}
+};
+
+// STL allocator taking memory from an arena (deallocation does nothing).
+// Without an arena, it falls back to the heap
+template <class T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  Arena *arena;
+
+  ArenaAllocator(Arena *a = NULL) : arena(a) {}
+  template <class U> ArenaAllocator(const ArenaAllocator<U> &o) : arena(o.arena) {}
+
+  T *allocate(size_t n) {
+    if (arena!=NULL) return (T *)arena->alloc(n*sizeof(T));
+    return (T *)::operator new(n*sizeof(T));
+  }
+  void deallocate(T *p, size_t n) {
+    if (arena==NULL) ::operator delete(p);
+  }
+
+  template <class U> bool operator==(const ArenaAllocator<U> &o) const {return arena==o.arena;}
+  template <class U> bool operator!=(const ArenaAllocator<U> &o) const {return arena!=o.arena;}
+};
+
+#endif
@@ -0,0 +1,123 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Library interface: census of a graph with a g-trie
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Census.h"
+#include "Error.h"
+#include "GraphMatrix.h"
+#include "GraphUtils.h"
+#include "Isomorphism.h"
+#include "Generator.h"
+#include <pthread.h>
+
+// Serialises the use of nauty
+static pthread_mutex_t _nauty = PTHREAD_MUTEX_INITIALIZER;
+
+// Errors throw while one of these lives (see Error::setThrow)
+class CensusThrow {
+  bool _old;
+ public:
+  CensusThrow()  {_old = Error::throwing(); Error::setThrow(true);}
+  ~CensusThrow() {Error::setThrow(_old);}
+};
+
+// Holds the nauty lock while it lives (also when an error is thrown)
+class NautyLock {
+ public:
+  NautyLock()  {pthread_mutex_lock(&_nauty);}
+  ~NautyLock() {pthread_mutex_unlock(&_nauty);}
+};
+
+double CensusResult::occurrences() {
+  double total = 0;
+  mapStringInt::const_iterator ii;
+  for (ii=freq.begin(); ii!=freq.end(); ii++)
+    total += ii->second;
+  return total;
+}
+
+Graph *Census::readGraph(const char *s, bool dir, bool weight, vector<string> *names) {
+  CensusThrow t;
+  vector<string> none;
+  Graph *g = new GraphMatrix();
+  try {
+    GraphUtils::readFileTxt(g, s, dir, weight, names!=NULL ? names : &none);
+  } catch (ErrorException &) {
+    delete g;
+    throw;
+  }
+  g->sortNeighbours();
+  g->makeArrayNeighbours();
+  return g;
+}
+
+GTrie *Census::readGTrie(const char *s) {
+  CensusThrow t;
+  GTrie *gt = new GTrie();
+  try {
+    gt->readFromFile((char *)s);
+  } catch (ErrorException &) {
+    delete gt;
+    throw;
+  }
+  return gt;
+}
+
+GTrie *Census::buildGTrie(int size, bool dir, vector<string> &v) {
+  CensusThrow t;
+  if (size<MIN_MOTIF_SIZE || size>MAX_MOTIF_SIZE)
+    Error::msg("Invalid subgraph size (%d <= SIZE <= %d)", MIN_MOTIF_SIZE, MAX_MOTIF_SIZE);
+  GTrie *gt = new GTrie();
+  try {
+    NautyLock l;
+    Isomorphism::initNauty(size, dir);
+    gt->insertSubgraphs(size, dir, v);
+  } catch (ErrorException &) {
+    delete gt;
+    throw;
+  }
+  return gt;
+}
+
+GTrie *Census::buildComplete(int size, bool dir) {
+  CensusThrow t;
+  vector<string> v;
+  if (size<MIN_MOTIF_SIZE || size>MAX_MOTIF_SIZE)
+    Error::msg("Invalid subgraph size (%d <= SIZE <= %d)", MIN_MOTIF_SIZE, MAX_MOTIF_SIZE);
+  {
+    NautyLock l;
+    Generator::connectedGraphs(size, dir, v);
+  }
+  return buildGTrie(size, dir, v);
+}
+
+void Census::run(Graph *g, GTrie *gt, const CensusOptions *o, CensusResult *r) {
+  CensusThrow t;
+  CensusOptions def;
+
+  if (o == NULL) {
+    memset(&def, 0, sizeof(CensusOptions));
+    o = &def;
+  }
+  gt->census(g, o);
+
+  r->size = gt->maxDepth();
+  r->dir  = (g->type() == DIRECTED);
+  r->freq.clear();
+  gt->populateMap(&r->freq, r->size);
+}
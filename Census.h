@@ -0,0 +1,64 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Library interface: census of a graph with a g-trie
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _CENSUS_
+#define _CENSUS_
+
+#include "Common.h"
+#include "Graph.h"
+#include "GTrie.h"
+
+// Frequencies found by a census
+class CensusResult {
+ public:
+  int size;
+  bool dir;
+  mapStringInt freq;  // Frequency of each subgraph found (adjacency matrix)
+
+  int subgraphs() {return freq.size();}
+  double occurrences();
+};
+
+// Everything an analysis uses lives in its graph, g-trie, options and
+// result, so analyses can run at the same time (e.g. on different threads),
+// as long as each census has its own g-trie (it keeps the frequencies).
+// Graphs are not changed by a census and can be shared. Nothing here reads
+// the state of the command line (Global, Esu, Checkpoint, Partition, Random).
+// What is still process-wide:
+//  - nauty, used to build g-tries, is not thread safe, so builds are serialised
+//  - the kernel of '-ix' (SetOps::init) and the processes used to generate
+//    the complete g-trie (Parallel::setJobs) are settings: set them, if at
+//    all, before any analysis starts
+// Errors throw an ErrorException (see Error.h) with their message, and what
+// the call allocated is freed. Nothing is shown nor exits.
+class Census {
+ public:
+  // Graph of file 's', ready for census. If its nodes are renumbered (see
+  // GraphUtils::readFileTxt) and 'names' is given, it gets their identifiers
+  // (to be passed on CensusOptions::names), else it is left empty
+  static Graph *readGraph(const char *s, bool dir, bool weight, vector<string> *names = NULL);
+  static GTrie *readGTrie(const char *s);                          // ASCII or binary
+  static GTrie *buildGTrie(int size, bool dir, vector<string> &v); // adjacency matrices
+  static GTrie *buildComplete(int size, bool dir);                 // all connected subgraphs
+
+  // Census of 'g' with 'gt' and options 'o' (NULL: defaults)
+  static void run(Graph *g, GTrie *gt, const CensusOptions *o, CensusResult *r);
+};
+
+#endif
@@ -0,0 +1,167 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Checkpointing of long censuses
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Checkpoint.h"
+#include "Error.h"
+#include <unistd.h>
+
+// Static variables
+FILE  *Checkpoint::_f = NULL;
+FILE  *Checkpoint::_occ = NULL;
+int    Checkpoint::_interval = CHECKPOINT_DEFAULT_INTERVAL;
+int    Checkpoint::_phase = 0;
+time_t Checkpoint::_last;
+map<int, CheckpointRecord> Checkpoint::_records;
+
+// Read file header
+bool Checkpoint::_readHeader(FILE *f, CheckpointHeader *h) {
+  char magic[8];
+  int version;
+
+  if (fread(magic, 1, 8, f)!=8 || memcmp(magic, CHECKPOINT_MAGIC, 8)) return false;
+  if (fread(&version, sizeof(int), 1, f)!=1 || version!=CHECKPOINT_VERSION) return false;
+  return fread(h, sizeof(CheckpointHeader), 1, f)==1;
+}
+
+// Read one record (false if incomplete, as when interrupted while writing)
+bool Checkpoint::_readRecord(FILE *f, CheckpointRecord *r) {
+  int mark, nfreq;
+
+  if (fread(&mark, sizeof(int), 1, f)!=1 || mark!=CHECKPOINT_MARK) return false;
+  if (fread(&r->phase, sizeof(int), 1, f)!=1) return false;
+  if (fread(&r->next, sizeof(int), 1, f)!=1) return false;
+  if (fread(&r->occ_offset, sizeof(long long), 1, f)!=1) return false;
+  if (fread(r->rng, 1, RANDOM_STATE_SIZE, f)!=RANDOM_STATE_SIZE) return false;
+  if (fread(&nfreq, sizeof(int), 1, f)!=1 || nfreq<0) return false;
+  r->freq.resize(nfreq);
+  if (nfreq>0 && fread(&r->freq[0], sizeof(int), nfreq, f)!=(size_t)nfreq) return false;
+  if (fread(&mark, sizeof(int), 1, f)!=1 || mark!=CHECKPOINT_MARK) return false;
+  return true;
+}
+
+// Start checkpointing to file 's' every 'interval' seconds
+void Checkpoint::open(const char *s, int interval, bool resume, CheckpointHeader *h) {
+  CheckpointHeader old;
+  CheckpointRecord r;
+  long valid;
+  FILE *f;
+
+  _interval = interval;
+  _records.clear();
+
+  f = resume ? fopen(s, "rb") : NULL;
+  if (f!=NULL) {
+    if (!_readHeader(f, &old))
+      Error::msg("Invalid checkpoint file \"%s\"", s);
+
+    // Seed was chosen on the first run, everything else must match
+    h->random_seed = old.random_seed;
+    if (memcmp(&old, h, sizeof(CheckpointHeader)))
+      Error::msg("Checkpoint file \"%s\" was created with different parameters", s);
+
+    valid = ftell(f);
+    while (_readRecord(f, &r)) {
+      _records[r.phase] = r;
+      valid = ftell(f);
+    }
+    fclose(f);
+
+    // Discard a possibly truncated last record
+    if (truncate(s, valid)!=0) Error::msg(NULL);
+    _f = fopen(s, "ab");
+    if (_f==NULL) Error::msg("Unable to open checkpoint file \"%s\"", s);
+    printf("Resuming from checkpoint \"%s\" (%d censuses started)\n", s, (int)_records.size());
+  } else {
+    int version = CHECKPOINT_VERSION;
+    _f = fopen(s, "wb");
+    if (_f==NULL) Error::msg("Unable to open checkpoint file \"%s\"", s);
+    fwrite(CHECKPOINT_MAGIC, 1, 8, _f);
+    fwrite(&version, sizeof(int), 1, _f);
+    fwrite(h, sizeof(CheckpointHeader), 1, _f);
+    fflush(_f);
+  }
+  _last = time(NULL);
+}
+
+void Checkpoint::close() {
+  if (_f!=NULL) fclose(_f);
+  _f = NULL;
+  _records.clear();
+}
+
+// Append record with the current state of census on 'gt'
+// ('next' is the first node that was not yet processed)
+void Checkpoint::save(int next, GTrie *gt) {
+  int mark = CHECKPOINT_MARK;
+  int nfreq = gt->countGraphs();
+  VInt freq(nfreq+1); // (not on the stack: a g-trie can have many subgraphs)
+  long long occ = -1;
+  char rng[RANDOM_STATE_SIZE];
+
+  if (_f==NULL) return;
+
+  gt->getFrequencies(&freq[0]);
+  Random::getState(rng);
+  if (_occ!=NULL) {
+    fflush(_occ);
+    occ = ftell(_occ);
+  }
+
+  fwrite(&mark, sizeof(int), 1, _f);
+  fwrite(&_phase, sizeof(int), 1, _f);
+  fwrite(&next, sizeof(int), 1, _f);
+  fwrite(&occ, sizeof(long long), 1, _f);
+  fwrite(rng, 1, RANDOM_STATE_SIZE, _f);
+  fwrite(&nfreq, sizeof(int), 1, _f);
+  fwrite(&freq[0], sizeof(int), nfreq, _f);
+  fwrite(&mark, sizeof(int), 1, _f);
+  fflush(_f);
+  fsync(fileno(_f));
+
+  _last = time(NULL);
+}
+
+// Restore frequencies of 'gt' from last record of 'phase'
+// and return in 'next' the node where census should continue
+bool Checkpoint::restore(int phase, GTrie *gt, int *next) {
+  char rng[RANDOM_STATE_SIZE];
+  map<int, CheckpointRecord>::iterator ii = _records.find(phase);
+
+  if (ii == _records.end()) return false;
+
+  CheckpointRecord &r = ii->second;
+  if ((int)r.freq.size() != gt->countGraphs())
+    Error::msg("Checkpoint does not match g-trie (%d subgraphs instead of %d)", (int)r.freq.size(), gt->countGraphs());
+
+  // Random networks are regenerated, so the generator must be where it was
+  Random::getState(rng);
+  if (memcmp(rng, r.rng, RANDOM_STATE_SIZE))
+    Error::msg("Random generator state does not match checkpoint (phase %d)", phase);
+
+  if (r.freq.size()>0) gt->setFrequencies(&r.freq[0]);
+  *next = r.next;
+  return true;
+}
+
+// Size of occurrences file when the original network was last saved
+long long Checkpoint::occOffset() {
+  map<int, CheckpointRecord>::iterator ii = _records.find(0);
+  if (ii == _records.end()) return -1;
+  return ii->second.occ_offset;
+}
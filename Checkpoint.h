@@ -0,0 +1,87 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Checkpointing of long censuses
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _CHECKPOINT_
+#define _CHECKPOINT_
+
+#include "Common.h"
+#include "GTrie.h"
+#include "Random.h"
+
+#define CHECKPOINT_MAGIC   "GTRIECKP" // First bytes of a checkpoint file
+#define CHECKPOINT_VERSION 2
+#define CHECKPOINT_MARK    0x47544350 // Delimits every record
+#define CHECKPOINT_DEFAULT_INTERVAL 300 // Seconds between checkpoints
+
+// Parameters of the run (must be the same when resuming)
+typedef struct {
+  int motif_size;
+  int dir;
+  int method;
+  int nodes;
+  int edges;
+  int random_number;
+  int random_seed;
+  int random_exchanges;
+  int random_tries;
+  int nparts;
+  int part;
+  int order;
+} CheckpointHeader;
+
+// State of one census (phase 0 is the original network,
+// phase i is the i-th random network)
+typedef struct {
+  int phase;                     // Which census
+  int next;                      // First node still to be processed
+  long long occ_offset;          // Size of occurrences file
+  char rng[RANDOM_STATE_SIZE];   // Random generator state
+  VInt freq;                     // Partial frequencies (see GTrie::getFrequencies)
+} CheckpointRecord;
+
+class Checkpoint {
+ private:
+  static FILE *_f;                            // Checkpoint file (appended)
+  static FILE *_occ;                          // Occurrences file (to keep in sync)
+  static int _interval;                       // Seconds between checkpoints
+  static int _phase;                          // Current census
+  static time_t _last;                        // Time of last checkpoint
+  static map<int, CheckpointRecord> _records; // Last record of each phase (when resuming)
+
+  static bool _readHeader(FILE *f, CheckpointHeader *h);
+  static bool _readRecord(FILE *f, CheckpointRecord *r);
+
+ public:
+  // Start checkpointing to file 's' every 'interval' seconds.
+  // If 'resume' is true, previous records are kept (and h->random_seed restored)
+  static void open(const char *s, int interval, bool resume, CheckpointHeader *h);
+  static void close();
+
+  static bool active() {return _f!=NULL;}
+  static bool due()    {return _f!=NULL && time(NULL)-_last >= _interval;}
+
+  static void setPhase(int p) {_phase = p;}
+  static void setOccurrences(FILE *f) {_occ = f;}
+
+  static void save(int next, GTrie *gt);               // Append record for current phase
+  static bool restore(int phase, GTrie *gt, int *next); // Load last record of 'phase'
+  static long long occOffset();                         // Valid size of occurrences file (-1 if none)
+};
+
+#endif
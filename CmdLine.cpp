@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Command Line Client functions
 
-Last Update: 23/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #include "CmdLine.h"
@@ -22,7 +22,10 @@ Last Update: 23/02/2012
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <set>
 #include <cmath>
+#include <unistd.h>
+#include <sys/stat.h>
 
 // ----------------------------------------------
 
@@ -33,22 +36,57 @@ char CmdLine::gtrie_file[MAX_BUF];
 char CmdLine::subgraphs_file[MAX_BUF];
 char CmdLine::output_file[MAX_BUF];
 char CmdLine::occ_file[MAX_BUF];
+char CmdLine::index_file[MAX_BUF];
+char CmdLine::orbit_file[MAX_BUF];
+char CmdLine::query_file[MAX_BUF];
+char CmdLine::query_class[MAX_BUF];
+char CmdLine::query_node[MAX_BUF];
+char CmdLine::checkpoint_file[MAX_BUF];
+char CmdLine::stream_file[MAX_BUF];
+char CmdLine::seeds_file[MAX_BUF];
+char CmdLine::cache_dir[MAX_BUF];
+char CmdLine::daemon_socket[MAX_BUF];
 
 bool CmdLine::dir;
 bool CmdLine::occurrences;
 bool CmdLine::create;
+bool CmdLine::convert;
+bool CmdLine::binary;
+bool CmdLine::resume;
+bool CmdLine::merge;
+bool CmdLine::daemon;
+bool CmdLine::intersect;
+bool CmdLine::delta;
 
 int  CmdLine::motif_size;
 int  CmdLine::random_number;
 int  CmdLine::random_seed;
 int  CmdLine::random_exchanges;
 int  CmdLine::random_tries;
+int  CmdLine::checkpoint_interval;
+int  CmdLine::jobs;
+int  CmdLine::color_number;
+int  CmdLine::color_samples;
+int  CmdLine::walk_number;
+int  CmdLine::walk_steps;
+int  CmdLine::stream_batch;
+int  CmdLine::window_size;
+int  CmdLine::window_step;
+int  CmdLine::workers;
+int  CmdLine::partition;
+int  CmdLine::partition_number;
+int  CmdLine::num_nodes;
+int  CmdLine::num_edges;
+
+double CmdLine::hybrid_sample;
 
 double CmdLine::time_original;
 double CmdLine::time_random;
 
 MethodType CmdLine::method;
 FormatType CmdLine::format;
+OrderType CmdLine::order;
+SetOpsType CmdLine::setops;
 OutputType CmdLine::output;
 Graph *CmdLine::g;
 
@@ -60,8 +98,19 @@ GTrie *CmdLine::gt_original;
 
 GraphTree CmdLine::sg_original;
 
+vector<int> CmdLine::seeds;
+vector<int> CmdLine::seed_dist;
+
+map<string, int> CmdLine::name_index;
+
 time_t CmdLine::t_start;
 
+char **CmdLine::merge_files;
+int    CmdLine::merge_number;
+
+map<string, CachedGraph> CmdLine::graph_cache;
+map<string, CachedGTrie> CmdLine::gtrie_cache;
+
 // ----------------------------------------------
 
 // Create a g-trie from a list of subgraphs
@@ -78,21 +127,160 @@ void CmdLine::create_gtrie() {
   gt_original->readSubgraphs(motif_size, dir, subgraphs_file);
   Timer::stop(0);
   printf("Creation time: %.2f\n", Timer::elapsed(0));
+  printf("G-Trie memory: %.2f MB\n", gt_original->memory()/(1024.0*1024.0));
   printf("Nr %d-subgraphs in g-trie: %d\n", motif_size, gt_original->countGraphs()); 
   printf("Compression rate = %.2f%%\n\n", gt_original->compressionRate()*100);
 
   // Write g-trie to file
-  gt_original->writeToFile(output_file);
-  printf("G-Trie written to file \"%s\"\n", output_file);
+  if (binary) gt_original->writeBinary(output_file);
+  else        gt_original->writeToFile(output_file);
+  printf("G-Trie written to file \"%s\"%s\n", output_file, binary?" (binary)":"");
 
   delete gt_original;
 }
 
+// Convert g-trie file between ASCII and binary formats
+void CmdLine::convert_gtrie() {
+  bool from_binary = GTrie::isBinary(gtrie_file);
+
+  printf("Reading G-Trie\n");
+  gt_original = new GTrie();
+  Timer::start(0);
+  gt_original->readFromFile(gtrie_file);
+  Timer::stop(0);
+  printf("Creation time: %.2f\n", Timer::elapsed(0));
+  printf("Nr subgraphs in g-trie: %d\n\n", gt_original->countGraphs());
+
+  if (from_binary) gt_original->writeToFile(output_file);
+  else             gt_original->writeBinary(output_file);
+  printf("G-Trie written to file \"%s\" (%s)\n", output_file, from_binary?"ASCII":"binary");
+
+  delete gt_original;
+}
+
+// Write the occurrences of an index asked by -qc and -qn
+// (to the output file if given)
+void CmdLine::query_index() {
+  FILE *f = stdout;
+
+  if (strcmp(output_file, DEFAULT_RESULTS)) {
+    f = fopen(output_file, "w");
+    if (f==NULL) Error::msg("Unable to open output file \"%s\"", output_file);
+  }
+
+  Timer::start(0);
+  long long n = OccIndex::query(query_file, query_class[0] ? query_class : NULL,
+				query_node[0] ? query_node : NULL, f);
+  Timer::stop(0);
+  if (f != stdout) fclose(f);
+
+  printf("%lld occurrences%s, %.6fs\n", n, query_class[0] || query_node[0] ? "" : " (classes listed)",
+	 Timer::elapsed(0));
+}
+
+// Graph of the request from the daemon cache (read if new or changed)
+Graph *CmdLine::cached_graph() {
+  string name;
+  long long mtime;
+  char key[MAX_BUF+64];
+
+  if (!Daemon::fileKey(graph_file, &name, &mtime))
+    return NULL; // the worker reports it
+  sprintf(key, "%s|%d|%d|%d", name.c_str(), (int)format, (int)dir, (int)order);
+
+  CachedGraph &c = graph_cache[key];
+  if (c.g == NULL || c.mtime != mtime) {
+    if (c.g != NULL) {
+      delete c.g;
+      delete[] c.labels;
+      delete c.names;
+      c.g = NULL;
+    }
+    g = NULL;
+    Global::labels = NULL;
+    Global::names  = NULL;
+    load_graph();
+    c.g      = g;
+    c.labels = Global::labels;
+    c.names  = Global::names;
+    c.mtime  = mtime;
+  }
+  Global::labels = c.labels;
+  Global::names  = c.names;
+  return c.g;
+}
+
+// G-Trie of file 's' from the daemon cache (read if new or changed)
+GTrie *CmdLine::cached_gtrie(char *s) {
+  string name;
+  long long mtime;
+
+  if (!Daemon::fileKey(s, &name, &mtime))
+    return NULL;
+
+  CachedGTrie &c = gtrie_cache[name];
+  if (c.gt == NULL || c.mtime != mtime) {
+    if (c.gt != NULL) {
+      delete c.gt;
+      c.gt = NULL;
+    }
+    GTrie *t = new GTrie();
+    t->readFromFile(s);
+    c.gt    = t;
+    c.mtime = mtime;
+  }
+  return c.gt;
+}
+
+// Prepare a request on the daemon: its graph and g-trie are taken from
+// the cache, so that the worker does not need to read them
+bool CmdLine::daemon_prepare(int argc, char **argv) {
+  about();
+  defaults();
+  parse_cmdargs(argc, argv);
+  if (daemon) Error::msg("Requests can not start a daemon");
+
+  if (merge || create || convert || strcmp(query_file, INVALID_FILE) || method == NOMETHOD ||
+      format == NOFORMAT || order == NOORDER || !strcmp(graph_file, INVALID_FILE))
+    return true; // nothing to cache (errors are reported by the worker)
+
+  g = cached_graph();
+  if (method == GTRIE)
+    gt_original = cached_gtrie(gtrie_file);
+  else if (method == COMPLETE) {
+    char cache[MAX_BUF+32];
+    Generator::cacheFile(cache_dir, motif_size, dir, cache);
+    if (access(cache, R_OK)==0) gt_original = cached_gtrie(cache);
+  }
+  return true;
+}
+
+// Run a prepared request (on a worker process)
+void CmdLine::daemon_run() {
+  configure();
+  decide_action();
+  finish();
+}
+
+// Serve requests on 'daemon_socket'
+void CmdLine::run_daemon() {
+  Daemon::serve(daemon_socket, workers, daemon_prepare, daemon_run);
+}
+
+// Send the arguments (but the client option at 'pos') to the daemon
+int CmdLine::run_client(int argc, char **argv, int pos) {
+  vector<char *> args;
+
+  for (int i=0; i<argc; i++)
+    if (i!=pos && i!=pos+1) args.push_back(argv[i]);
+  return Daemon::client(argv[pos+1], args.size(), &args[0]);
+}
+
 // ----------------------------------------------
 
 // Run ESU algorithm on graph 'g' and store results on GraphTree 'gt'
 void CmdLine::run_esu(Graph *g, GraphTree *sg) {
-  Esu::countSubgraphs(g, motif_size, sg);
+  Esu::countSubgraphs(g, motif_size, sg, seed_distances(g));
 }
 
 // Run SUBGRAPHS method on graph 'g' and store results on GraphTree 'gt'
@@ -103,26 +291,207 @@ void CmdLine::run_subgraphs(Graph *g, GraphTree *sg) {
   gt_original->readSubgraphs(motif_size, dir, subgraphs_file);
   Timer::stop(0);
   printf("Creation time: %.2f\n", Timer::elapsed(0));
+  printf("G-Trie memory: %.2f MB\n", gt_original->memory()/(1024.0*1024.0));
   printf("Compression rate = %.2f%%\n\n", gt_original->compressionRate()*100);
 
-  gt_original->census(g);
+  run_census(gt_original, g, 0);
   gt_original->populateGraphTree(sg, motif_size);
 }
 
 // Run GTRIES method on graph 'g' and store results on GraphTree 'gt'
 void CmdLine::run_gtrie(Graph *g, GraphTree *sg) {
-  printf("Reading G-Trie\n");
-  gt_original = new GTrie();
   Timer::start(0);
-  gt_original->readFromFile(gtrie_file);
+  if (gt_original == NULL) {
+    printf("Reading G-Trie\n");
+    gt_original = new GTrie();
+    gt_original->readFromFile(gtrie_file);
+  } else
+    printf("Using cached G-Trie\n");
   Timer::stop(0);
   printf("Creation time: %.2f\n", Timer::elapsed(0));
+  printf("G-Trie memory: %.2f MB\n", gt_original->memory()/(1024.0*1024.0));
+  printf("Compression rate = %.2f%%\n\n", gt_original->compressionRate()*100);
+
+  run_census(gt_original, g, 0);
+  gt_original->populateGraphTree(sg, motif_size);
+}
+
+// Run COMPLETE method on graph 'g' and store results on GraphTree 'gt'
+// (g-trie with all subgraphs, generated once and then cached)
+void CmdLine::run_complete(Graph *g, GraphTree *sg) {
+  char cache[MAX_BUF+32], tmp[MAX_BUF+64];
+
+  Generator::cacheFile(cache_dir, motif_size, dir, cache);
+  Timer::start(0);
+  if (gt_original != NULL)
+    printf("Using cached G-Trie \"%s\"\n", cache);
+  else if (access(cache, R_OK)==0) {
+    printf("Reading G-Trie \"%s\"\n", cache);
+    gt_original = new GTrie();
+    gt_original->readFromFile(cache);
+  } else {
+    printf("Generating G-Trie with all %s %d-subgraphs\n", dir?"directed":"undirected", motif_size);
+    vector<string> v;
+    gt_original = new GTrie();
+    Generator::connectedGraphs(motif_size, dir, v);
+    gt_original->insertSubgraphs(motif_size, dir, v);
+
+    // Written under another name first, so that concurrent runs never read half a file
+    mkdir(cache_dir, 0755);
+    sprintf(tmp, "%s.%d", cache, (int)getpid());
+    gt_original->writeBinary(tmp);
+    if (rename(tmp, cache)!=0) Error::msg("Unable to write g-trie cache \"%s\"", cache);
+    printf("G-Trie cached on \"%s\"\n", cache);
+  }
+  Timer::stop(0);
+  printf("Creation time: %.2f\n", Timer::elapsed(0));
+  printf("G-Trie memory: %.2f MB\n", gt_original->memory()/(1024.0*1024.0));
+  printf("Nr %d-subgraphs in g-trie: %d\n", motif_size, gt_original->countGraphs()); 
   printf("Compression rate = %.2f%%\n\n", gt_original->compressionRate()*100);
 
-  gt_original->census(g);
+  run_census(gt_original, g, 0);
   gt_original->populateGraphTree(sg, motif_size);
 }
 
+// Sampling of the HYBRID method (see run_hybrid)
+typedef struct {
+  double *prob;            // Sampling probabilities of each depth
+  std::set<string> *found; // Classes found (nauty also defines a "set")
+} HybridJob;
+
+// Sampling census of the roots [first, last), writing the classes found
+// (canonical adjacency strings)
+void CmdLine::_hybridWork(int first, int last, FILE *out, void *arg) {
+  HybridJob *job = (HybridJob *)arg;
+  GraphTree sg;
+  mapStringInt m;
+  mapStringInt::const_iterator ii;
+
+  Esu::countSubgraphsSample(g, motif_size, &sg, job->prob, first, last, random_seed);
+  sg.populateMap(&m, motif_size);
+  for (ii=m.begin(); ii!=m.end(); ii++)
+    if (ii->second > 0)
+      fwrite(ii->first.c_str(), 1, motif_size*motif_size, out);
+}
+
+void CmdLine::_hybridMerge(FILE *in, void *arg) {
+  HybridJob *job = (HybridJob *)arg;
+  char s[motif_size*motif_size+1];
+
+  s[motif_size*motif_size] = 0;
+  while (fread(s, 1, motif_size*motif_size, in)==(size_t)(motif_size*motif_size))
+    job->found->insert(s);
+}
+
+// Run HYBRID method on graph 'g' and store results on GraphTree 'gt'
+// (sampling finds the subgraphs that occur, and a g-trie with just
+// those gives their exact frequencies)
+void CmdLine::run_hybrid(Graph *g, GraphTree *sg) {
+  std::set<string> found;
+  HybridJob job;
+  int i;
+
+  // Each k-subgraph is found with probability 'hybrid_sample'
+  job.prob  = new double[motif_size];
+  job.found = &found;
+  job.prob[0] = 1;
+  for (i=1; i<motif_size; i++)
+    job.prob[i] = pow(hybrid_sample, 1.0/(motif_size-1));
+
+  gt_original = new GTrie();
+  Timer::start(0);
+  printf("Sampling %.2f%% of the %d-subgraphs\n", hybrid_sample*100, motif_size);
+  Parallel::run(g->numNodes(), _hybridWork, _hybridMerge, &job);
+  vector<string> v(found.begin(), found.end());
+  gt_original->insertSubgraphs(motif_size, dir, v);
+  Timer::stop(0);
+  printf("Creation time: %.2f\n", Timer::elapsed(0));
+  printf("G-Trie memory: %.2f MB\n", gt_original->memory()/(1024.0*1024.0));
+  printf("Nr %d-subgraphs in g-trie: %d\n", motif_size, gt_original->countGraphs()); 
+  delete[] job.prob;
+
+  // Nothing sampled: no subgraphs to count (on the random networks too)
+  if (found.empty()) {
+    printf("\nNo subgraphs found by sampling (see '-hs')\n");
+    return;
+  }
+  printf("Compression rate = %.2f%%\n\n", gt_original->compressionRate()*100);
+  run_census(gt_original, g, 0);
+  gt_original->populateGraphTree(sg, motif_size);
+}
+
+// Run TRIADS method on graph 'g' and store results on GraphTree 'gt'
+// (frequencies of size 3 in closed form, see Triads)
+void CmdLine::run_triads(Graph *g, GraphTree *sg) {
+  long long count[TRIAD_CODES];
+
+  Triads::census(g, count);
+  Triads::populateGraphTree(count, dir, sg);
+}
+
+// Run GRAPHLETS method on graph 'g' and store results on GraphTree 'gt'
+// (undirected frequencies of size 4 from equations, see Graphlets),
+// writing the orbits of each node if 'orbits' is true
+void CmdLine::run_graphlets(Graph *g, GraphTree *sg, bool orbits) {
+  long long *orb = new long long[(long long)g->numNodes()*GRAPHLET_ORBITS];
+
+  Graphlets::census(g, orb);
+  Graphlets::populateGraphTree(orb, g->numNodes(), sg);
+  if (orbits) write_orbits(g, orb);
+  delete[] orb;
+}
+
+// Write the orbits of each node (one line per node, with its label)
+void CmdLine::write_orbits(Graph *g, const long long *orbits) {
+  int i, j;
+  char s[17];
+
+  FILE *f = fopen(orbit_file, "w");
+  if (f==NULL) Error::msg("Unable to open orbits file \"%s\"", orbit_file);
+  fprintf(f, "Graph File: \"%s\"\nSubgraph Size: 4\n", graph_file);
+  for (i=0; i<GRAPHLET_ORBITS; i++) {
+    Graphlets::orbitClass(i, s);
+    fprintf(f, "Orbit %2d: %s %s\n", i, s, Graphlets::orbitName(i));
+  }
+  fprintf(f, "%s\nNode Orbit_0 ... Orbit_%d\n", SEPARATOR, GRAPHLET_ORBITS-1);
+  for (i=0; i<g->numNodes(); i++) {
+    Global::writeLabel(f, i, "");
+    for (j=0; j<GRAPHLET_ORBITS; j++)
+      fprintf(f, " %lld", orbits[(long long)i*GRAPHLET_ORBITS+j]);
+    fputc('\n', f);
+  }
+  fclose(f);
+}
+
+// Run g-trie census on graph 'g', continuing from the checkpoint
+// of census 'phase' (0 is original network, i is i-th random network)
+void CmdLine::run_census(GTrie *t, Graph *g, int phase) {
+  int first = 0;
+
+  Checkpoint::setPhase(phase);
+  if (Checkpoint::restore(phase, t, &first) && first>=g->numNodes())
+    return; // census was already complete
+
+  CensusOptions o;
+  memset(&o, 0, sizeof(CensusOptions));
+  o.intersect = intersect;
+  o.occ       = Global::show_occ ? Global::occ_file : NULL;
+  o.index     = Global::occ_index;
+  o.labels    = Global::labels;
+  o.names     = Global::names!=NULL ? &(*Global::names)[0] : NULL;
+  o.roots     = Partition::roots();
+  o.first     = first;
+  o.progress  = Checkpoint::active() ? census_progress : NULL;
+  o.seedDist  = seed_distances(g);
+  t->census(g, &o);
+  Checkpoint::save(g->numNodes(), t);
+}
+
+// Called after each root of a census (next is the following root)
+void CmdLine::census_progress(int next, GTrie *t) {
+  if (Checkpoint::due()) Checkpoint::save(next, t);
+}
+
 // ----------------------------------------------
 
 // Compare two different motif results (for sorting)
@@ -146,22 +515,66 @@ void CmdLine::prepare_files() {
   if (output == NOOUTPUT)
     Error::msg("No valid output format specified");    
 
-  if (!strcmp(output_file,  DEFAULT_RESULTS)) {
-    if (output == TEXT) strcat(output_file, ".txt");
-    else if (output == HTML) strcat(output_file, ".html");
-  }
+  // Partial results are written in binary at the end
+  if (partition_number > 0) {
+    if (!strcmp(output_file,  DEFAULT_RESULTS))
+      sprintf(output_file, "%s_%d.part", DEFAULT_RESULTS, partition);
+  } else {
+    if (!strcmp(output_file,  DEFAULT_RESULTS)) {
+      if (output == TEXT) strcat(output_file, ".txt");
+      else if (output == HTML) strcat(output_file, ".html");
+    }
 
-  f_output = fopen(output_file, "w");
-  if (f_output==NULL)
-    Error::msg("Unable to open output file \"%s\"", output_file);    
+    f_output = fopen(output_file, "w");
+    if (f_output==NULL)
+      Error::msg("Unable to open output file \"%s\"", output_file);
+  }
 
   if (occurrences) {
-    f_occ = fopen(occ_file, "w");
+    long long offset = Checkpoint::occOffset();
+    if (offset>=0) { // Keep occurrences dumped before last checkpoint
+      f_occ = fopen(occ_file, "r+");
+      if (f_occ!=NULL && ftruncate(fileno(f_occ), offset)==0)
+	fseek(f_occ, 0, SEEK_END);
+    } else
+      f_occ = fopen(occ_file, "w");
     if (f_occ==NULL)
       Error::msg("Unable to open occurrences file \"%s\"", occ_file);
+    Checkpoint::setOccurrences(f_occ);
   }
 }
 
+// Start (or resume) checkpointing of the computation
+void CmdLine::prepare_checkpoint() {
+  CheckpointHeader h;
+
+  if (!strcmp(checkpoint_file, INVALID_FILE)) {
+    if (resume) Error::msg("No checkpoint file specified for resuming");
+    return;
+  }
+
+  memset(&h, 0, sizeof(CheckpointHeader));
+  h.motif_size       = motif_size;
+  h.dir              = dir;
+  h.method           = method;
+  h.nodes            = g->numNodes();
+  h.edges            = g->numEdges();
+  h.random_number    = random_number;
+  h.random_seed      = random_seed;
+  h.random_exchanges = random_exchanges;
+  h.random_tries     = random_tries;
+  h.nparts           = partition_number;
+  h.part             = partition;
+  h.order            = order;
+  Checkpoint::open(checkpoint_file, checkpoint_interval, resume, &h);
+
+  // Random networks must be the same as before
+  random_seed = h.random_seed;
+  Random::seed(random_seed);
+
+  printf("Checkpointing to \"%s\" every %ds\n", checkpoint_file, checkpoint_interval);
+}
+
 // Prepare the original graph for computation
 void CmdLine::prepare_graph() {
 
@@ -177,24 +590,131 @@ void CmdLine::prepare_graph() {
   if (format == NOFORMAT)
     Error::msg("No valid graph format specified");
 
+  // Check node order
+  if (order == NOORDER)
+    Error::msg("No valid node order specified");
+
+  // The daemon may have it already
+  if (g == NULL) load_graph();
+
+  num_nodes = g->numNodes();
+  num_edges = dir?g->numEdges():g->numEdges()/2;
+
+  // Print chosen parameters
+  printf("Subgraph Size: %d\n", motif_size);
+  printf("Graph File: %s\n", graph_file);
+  printf("%s, %d Nodes, %d Edges\n", dir?"Directed":"Undirected", num_nodes, num_edges);
+  if (intersect) printf("Set operations: %s\n", SetOps::name());
+
+  // Only subgraphs with seeds are counted
+  if (strcmp(seeds_file, INVALID_FILE)) {
+    read_seeds();
+    printf("Seeds: %d nodes from \"%s\"\n", (int)seeds.size(), seeds_file);
+  }
+
+  // Keep only the root nodes of our partition
+  if (partition_number > 0) {
+    Partition::assign(g, partition, partition_number);
+    printf("Partition %d of %d (%d partitions)\n", partition, partition_number, partition_number);
+  }
+}
+
+// Label (from 0) of the node with identifier 's' on the graph file.
+// Nodes not on the graph get the next labels if 'add' (else -1)
+int CmdLine::file_node(const char *s, bool add) {
+  int i, v;
+  char id[16];
+
+  // Numbered as on the file. A new node switches to identifiers (as if
+  // renumbered when read), so that its value does not size the graph
+  if (Global::names == NULL) {
+    if (GraphUtils::isNumber(s, &v) && v >= 1 && v <= num_nodes) return v-1;
+    if (!add) return -1;
+    Global::names = new vector<string>(num_nodes);
+    for (i=0; i<num_nodes; i++) {
+      sprintf(id, "%d", i+1);
+      (*Global::names)[i] = id;
+    }
+    name_index.clear();
+  }
+
+  if (name_index.empty())
+    for (i=0; i<(int)Global::names->size(); i++)
+      name_index[(*Global::names)[i]] = i;
+  map<string, int>::iterator ii = name_index.find(s);
+  if (ii != name_index.end()) return ii->second;
+  if (!add) return -1;
+  Global::names->push_back(s);
+  return name_index[s] = Global::names->size()-1;
+}
+
+// Read the nodes of the seeds file (identifiers as on the graph file)
+void CmdLine::read_seeds() {
+  int i, a;
+  char s[MAX_BUF];
+  vector<int> node(num_nodes);
+
+  FILE *f = fopen(seeds_file, "r");
+  if (f==NULL) Error::msg("Unable to open seeds file \"%s\"", seeds_file);
+
+  for (i=0; i<num_nodes; i++)
+    node[Global::labels!=NULL ? Global::labels[i]-1 : i] = i;
+
+  seeds.clear();
+  while (fscanf(f, "%1023s", s)==1) {
+    a = file_node(s, false);
+    if (a<0) Error::msg("Seed \"%s\" is not a node of the graph", s);
+    seeds.push_back(node[a]);
+  }
+  fclose(f);
+  if (seeds.empty()) Error::msg("No seeds on file \"%s\"", seeds_file);
+}
+
+// Distance of each node of 'g' to the seeds (NULL if there are none).
+// Random networks change it, so it is computed for each census
+const int *CmdLine::seed_distances(Graph *g) {
+  if (seeds.empty()) return NULL;
+  seed_dist.resize(g->numNodes());
+  GraphUtils::seedDistances(g, seeds, motif_size-1, &seed_dist[0]);
+  return &seed_dist[0];
+}
+
+// Read the graph file on 'g' (ready for the census)
+void CmdLine::load_graph() {
+
   // Read the graph file
   g = new GraphMatrix();
 
   // Use simple or simple_weight text format
+  // (nodes with sparse or non integer identifiers are renumbered)
+  Global::names = new vector<string>;
   if (format == SIMPLE)
-    GraphUtils::readFileTxt(g, graph_file, dir, false);
+    GraphUtils::readFileTxt(g, graph_file, dir, false, Global::names);
   else if  (format == SIMPLE_WEIGHT)
-    GraphUtils::readFileTxt(g, graph_file, dir, true);
+    GraphUtils::readFileTxt(g, graph_file, dir, true, Global::names);
   else printf("??");
+  if (Global::names->empty()) {
+    delete Global::names;
+    Global::names = NULL;
+  }
+
+  // Renumber nodes (occurrences still use the original labels)
+  if (order != NATURAL) {
+    Graph *old = g;
+    Timer::start(0);
+    Global::labels = new int[old->numNodes()];
+    GraphUtils::orderNodes(old, order, Global::labels);
+    g = new GraphMatrix();
+    GraphUtils::renumberGraph(old, g, Global::labels);
+    for (int i=0; i<g->numNodes(); i++) Global::labels[i]++;
+    delete old;
+    Timer::stop(0);
+    printf("Nodes renumbered in %.2fs\n", Timer::elapsed(0));
+  }
 
   // sort and create array of neighbours
   g->sortNeighbours();
   g->makeArrayNeighbours();
-
-  // Print chosen parameters
-  printf("Subgraph Size: %d\n", motif_size);
-  printf("Graph File: %s\n", graph_file);
-  printf("%s, %d Nodes, %d Edges\n", dir?"Directed":"Undirected",g->numNodes(), dir?g->numEdges():g->numEdges()/2);
 }
 
 // Count subgraphs on original network
@@ -207,80 +727,182 @@ void CmdLine::compute_original() {
     printf("Method:     GTRIE with file containing complete g-trie\n");
   else if (method == SUBGRAPHS)
     printf("Method:     GTRIE with subgraphs read from file\n");
+  else if (method == COMPLETE)
+    printf("Method:     GTRIE with all subgraphs (generated)\n");
+  else if (method == HYBRID)
+    printf("Method:     GTRIE with subgraphs found by sampling\n");
+  else if (method == TRIADS)
+    printf("Method:     Triad census in closed form\n");
+  else if (method == GRAPHLETS)
+    printf("Method:     Graphlet equations\n");
 
   // Compute frequency
   Global::show_occ = occurrences;
   Global::occ_file = f_occ;
+  if (strcmp(index_file, INVALID_FILE))
+    Global::occ_index = new OccIndex(index_file, motif_size);
   puts("\nCounting subgraph frequency on 'ORIGINAL NETWORK'");
   Timer::start(0);
   if (method == ESU) run_esu(g, &sg_original);
   else if (method == SUBGRAPHS) run_subgraphs(g, &sg_original);
   else if (method == GTRIE) run_gtrie(g, &sg_original);
+  else if (method == COMPLETE) run_complete(g, &sg_original);
+  else if (method == HYBRID) run_hybrid(g, &sg_original);
+  else if (method == TRIADS) run_triads(g, &sg_original);
+  else if (method == GRAPHLETS) run_graphlets(g, &sg_original, strcmp(orbit_file, INVALID_FILE));
   Timer::stop(0);  
   printf("%d subgraphs, ",   sg_original.countGraphs());
   printf("%.0f occurrences\n", sg_original.countOccurrences());
   printf("Time elapsed: %.6fs\n\n", Timer::elapsed(0));
   Global::show_occ = false;
 
+  if (Global::occ_index != NULL) {
+    Timer::start(0);
+    Global::occ_index->close(Global::names);
+    Timer::stop(0);
+    printf("Occurrence index built in %.6fs\n\n", Timer::elapsed(0));
+    delete Global::occ_index;
+    Global::occ_index = NULL;
+  }
+
   time_original = Timer::elapsed(0);
 }
 
 // Compute random networks and output results
 void CmdLine::compute_results() {
-  int i, j;
-  mapStringInt:: const_iterator ii, iiend;
+  int i;
+  vector<mapStringInt> m_count(random_number+1); // [0] is the original network
+  mapStringInt m_delta;
+  DeltaCensus *dc = NULL;
 
-  // Create map and init results
-  mapStringInt m_original;  
-  sg_original.populateMap(&m_original, motif_size);
-  ResultType res[m_original.size()];
-  for (ii=m_original.begin(), iiend=m_original.end(), i=0; ii!=iiend; ii++, i++) {
-    res[i].s = strdup((ii->first).c_str());    
-    res[i].f_original = ii->second;
-    res[i].z_score = res[i].avg_random = res[i].dev_random = 0;
-  }
+  sg_original.populateMap(&m_count[0], motif_size);
 
   // Do we have random networks to compute?
+  time_random = 0;
   if (random_number > 0) {
-    gt = new GTrie;
-    sg_original.populateGTrieNauty(gt, motif_size, dir);
-    
-    mapStringInt m_count[random_number];
+    if (delta) {
+      m_delta = m_count[0];
+      dc = new DeltaCensus(g, motif_size, dir, &m_delta);
+    }
+    else if (partition_number == 0 && method != TRIADS && method != GRAPHLETS) {
+      gt = new GTrie;
+      sg_original.populateGTrieNauty(gt, motif_size, dir);
+    }
 
     // Generate all random networks
     printf("Computing random networks: ");
-    time_random = 0;
     for (i=0; i<random_number; i++) {      
 
       // Create new random network from previous one
+      // (a delta census is kept up to date with each swap)
       g->makeVectorNeighbours();
-      Random::markovChainPerEdge(g, random_exchanges, random_tries);
+      if (delta) Timer::start(0);
+      Random::markovChainPerEdge(g, random_exchanges, random_tries,
+				 delta?DeltaCensus::swapHook:NULL, dc);
       g->sortNeighbours();
       g->makeArrayNeighbours();
 
       // Compute census
-      Timer::start(0);
-      gt->census(g);
+      if (delta) m_count[i+1] = m_delta;
+      else {
+	Timer::start(0);
+	count_random(i+1, &m_count[i+1]);
+      }
       Timer::stop(0);
       time_random += Timer::elapsed(0);
-      gt->populateMap(&m_count[i], motif_size);
       fputc('.', stdout);      
     }
     fputc('\n', stdout);
     time_random /= (double)random_number;
+    if (dc != NULL) delete dc;
     printf("Avg time per random network: %.6fs\n\n", time_random);
+  }
+
+  // Partial results are only merged later
+  if (partition_number > 0) {
+    PartialHeader h;
+    memset(&h, 0, sizeof(PartialHeader));
+    h.motif_size       = motif_size;
+    h.dir              = dir;
+    h.method           = method;
+    h.nodes            = num_nodes;
+    h.edges            = num_edges;
+    h.random_number    = random_number;
+    h.random_seed      = random_seed;
+    h.random_exchanges = random_exchanges;
+    h.random_tries     = random_tries;
+    h.nparts           = partition_number;
+    h.part             = partition;
+    h.order            = order;
+    h.time_original    = time_original;
+    h.time_random      = time_random;
+    Partition::writeResults(output_file, &h, graph_file, m_count);
+    printf("Partial results written to file \"%s\"\n", output_file);
+  } else {
+    report_results(m_count);
+    printf("Results written to file \"%s\"\n", output_file);
+  }
+  if (occurrences)
+    printf("Occurences on original network written to file \"%s\"\n", occ_file);
+  if (strcmp(index_file, INVALID_FILE))
+    printf("Index of occurrences on original network written to file \"%s\"\n", index_file);
+  if (strcmp(orbit_file, INVALID_FILE))
+    printf("Orbits on original network written to file \"%s\"\n", orbit_file);
+}
+
+// Census of random network 'phase'. Normally the g-trie has the subgraphs
+// found on the original network, but a partition may not have found them
+// all, so in that case we use the same method as on the original network
+// (as we do for methods without a g-trie)
+void CmdLine::count_random(int phase, mapStringInt *m) {
+  if (method == TRIADS || method == GRAPHLETS) {
+    GraphTree sg;
+    if (method == TRIADS) run_triads(g, &sg);
+    else                  run_graphlets(g, &sg, false);
+    sg.populateMap(m, motif_size);
+  } else if (partition_number == 0) {
+    run_census(gt, g, phase);
+    gt->populateMap(m, motif_size);
+  } else if (method == ESU) {
+    GraphTree sg;
+    run_esu(g, &sg);
+    sg.populateMap(m, motif_size);
+  } else {
+    // (through a GraphTree, whose strings are the canonical ones of the original network)
+    GraphTree sg;
+    run_census(gt_original, g, phase);
+    gt_original->populateGraphTree(&sg, motif_size);
+    sg.populateMap(m, motif_size);
+  }
+}
 
-    // Compute significance
+// Compute significance and output results
+// (m_count[0] has the frequencies on the original network)
+void CmdLine::report_results(vector<mapStringInt> &m_count) {
+  int i, j;
+  mapStringInt:: const_iterator ii, iiend;
+  mapStringInt &m_original = m_count[0];
+
+  // Create map and init results (on the heap: large g-tries have many subgraphs)
+  ResultType *res = new ResultType[m_original.size()];
+  for (ii=m_original.begin(), iiend=m_original.end(), i=0; ii!=iiend; ii++, i++) {
+    res[i].s = strdup((ii->first).c_str());    
+    res[i].f_original = ii->second;
+    res[i].z_score = res[i].avg_random = res[i].dev_random = 0;
+  }
+
+  // Compute significance
+  if (random_number > 0) {
     for (ii=m_original.begin(), iiend=m_original.end(), i=0; ii!=iiend; ii++, i++) {
       // Average frequency
       double avg = 0;
-      for (j=0; j<random_number; j++)
+      for (j=1; j<=random_number; j++)
 	avg += m_count[j][ii->first];
       avg /= random_number;
 
       // Standard deviation
       double dev=0;
-      for (j=0; j<random_number; j++)
+      for (j=1; j<=random_number; j++)
 	dev += double(m_count[j][ii->first]-avg)*double(m_count[j][ii->first]-avg)/double(random_number-1);
       dev = sqrt(dev);
 
@@ -298,12 +920,368 @@ void CmdLine::compute_results() {
 
   // print results
   show_results(res, m_original.size());
-  printf("Results written to file \"%s\"\n", output_file);
-  if (occurrences)
-    printf("Occurences on original network written to file \"%s\"\n", occ_file);
 
   for (i=0; i<(int)m_original.size(); i++)
     free(res[i].s);
+  delete[] res;
+}
+
+// Follow the updates of the stream file, keeping the frequencies of the
+// original network up to date, and write a snapshot after each batch
+void CmdLine::compute_stream() {
+  int i, n, nodes, a, b, *node;
+  long long updates = 0;
+  char op, sa[MAX_BUF], sb[MAX_BUF];
+  mapStringInt m_count;
+  map<iPair, bool> batch;
+  map<iPair, bool>::iterator ii;
+
+  FILE *f = fopen(stream_file, "r");
+  if (f==NULL) Error::msg("Unable to open stream file \"%s\"", stream_file);
+
+  // Nodes only on the stream are added to the graph
+  nodes = g->numNodes();
+  while (fscanf(f, " %c %1023s %1023s", &op, sa, sb)==3) {
+    a = file_node(sa, true);
+    b = file_node(sb, true);
+    if (a<0 || b<0) Error::msg("Invalid update \"%c %s %s\" on stream file", op, sa, sb);
+    nodes = max(nodes, max(a, b)+1);
+  }
+  rewind(f);
+  if (nodes > g->numNodes()) grow_graph(nodes);
+
+  // Stream uses the original labels
+  node = new int[nodes];
+  for (i=0; i<nodes; i++) node[i] = i;
+  if (Global::labels!=NULL)
+    for (i=0; i<num_nodes; i++) node[Global::labels[i]-1] = i;
+
+  sg_original.populateMap(&m_count, motif_size);
+  g->makeVectorNeighbours();
+  DeltaCensus dc(g, motif_size, dir, &m_count);
+
+  printf("Following updates of \"%s\" (batches of %d)\n", stream_file, stream_batch);
+  fprintf(f_output, "Subgraph Size: %d\nGraph File: \"%s\"\nStream File: \"%s\"\nDirected: %s\n%s\n",
+	  motif_size, graph_file, stream_file, dir?"YES":"NO", SEPARATOR);
+  fprintf(f_output, "Snapshot 0: 0 updates, %d edges, 0.000000s\n", dir?g->numEdges():g->numEdges()/2);
+  write_frequencies(&m_count);
+
+  Timer::start(0);
+  for (i=1; (n = read_updates(f, stream_batch, node, &batch)) > 0; i++) {
+    for (ii=batch.begin(); ii!=batch.end(); ii++)
+      if (ii->second) dc.addEdge(ii->first.first, ii->first.second);
+      else            dc.rmEdge(ii->first.first, ii->first.second);
+    updates += n;
+    Timer::stop(0);
+    fprintf(f_output, "Snapshot %d: %lld updates, %d edges, %.6fs\n",
+	    i, updates, dir?g->numEdges():g->numEdges()/2, Timer::elapsed(0));
+    write_frequencies(&m_count);
+  }
+  Timer::stop(0);
+  fclose(f);
+  delete[] node;
+
+  g->sortNeighbours();
+  g->makeArrayNeighbours();
+
+  printf("%lld updates in %d batches, %.6fs (%.0f updates/s)\n", updates, i-1,
+	 Timer::elapsed(0), updates/max(Timer::elapsed(0), 1e-9));
+  printf("Snapshots written to file \"%s\"\n", output_file);
+}
+
+// Read next (at most) 'max' updates into 'batch', where only the last
+// update of each edge is kept. Returns number of updates read
+int CmdLine::read_updates(FILE *f, int max, int *node, map<iPair, bool> *batch) {
+  int n, a, b;
+  char op, sa[MAX_BUF], sb[MAX_BUF];
+
+  batch->clear();
+  for (n=0; n<max && fscanf(f, " %c %1023s %1023s", &op, sa, sb)==3; n++) {
+    if (op!='+' && op!='-')
+      Error::msg("Invalid update \"%c %s %s\" on stream file", op, sa, sb);
+    a = node[file_node(sa, true)]; // (all known after the first pass)
+    b = node[file_node(sb, true)];
+    if (a==b) continue; // self loops are discarded
+    if (!dir && a>b) swap(a, b);
+    (*batch)[iPair(a, b)] = (op=='+');
+  }
+  return n;
+}
+
+// Replace graph by a copy with 'nodes' nodes
+void CmdLine::grow_graph(int nodes) {
+  int i;
+  vector<int> *v;
+  vector<int>::iterator ii;
+  Graph *old = g;
+
+  g = new GraphMatrix();
+  g->createGraph(nodes, old->type());
+  for (i=0; i<old->numNodes(); i++) {
+    v = old->outEdges(i);
+    for (ii=v->begin(); ii!=v->end(); ii++)
+      g->addEdge(i, *ii);
+  }
+  g->sortNeighbours();
+  g->makeArrayNeighbours();
+  delete old;
+}
+
+// Subgraphs found (adjacency matrix and frequency, one per line)
+void CmdLine::write_frequencies(mapStringInt *m) {
+  mapStringInt::iterator ii;
+
+  for (ii=m->begin(); ii!=m->end(); ii++)
+    if (ii->second > 0)
+      fprintf(f_output, "%s %d\n", ii->first.c_str(), ii->second);
+  fputc('\n', f_output);
+  fflush(f_output);
+}
+
+// Slide a window of 'window_size' time units (by 'window_step') over the
+// timed edges of the graph file, writing the frequencies of each window.
+// Frequencies are updated only with the edges entering and leaving
+// (an edge is on the window while any of its occurrences is)
+void CmdLine::compute_temporal() {
+  int i, n, nodes;
+  long long start;
+  vector<TimedEdge> e;
+  vector<string> names;
+  vector<iPair> changed;
+  map<iPair, int> mult;
+  mapStringInt m_count;
+
+  if (motif_size<MIN_MOTIF_SIZE || motif_size>DELTA_MAX_SIZE)
+    Error::msg("Invalid subgraph size for temporal mode (%d <= SIZE <= %d)", MIN_MOTIF_SIZE, DELTA_MAX_SIZE);
+  if (!strcmp(graph_file, INVALID_FILE))
+    Error::msg("No graph file specified");
+  if (format != SIMPLE_WEIGHT)
+    Error::msg("Temporal mode (-tw) needs the time of each edge (format simple_weight)");
+
+  nodes = GraphUtils::readTimedEdges(graph_file, &e, &names);
+  n = e.size();
+  if (n == 0) Error::msg("No edges on graph file \"%s\"", graph_file);
+
+  GraphMatrix tg;
+  tg.createGraph(nodes, dir?DIRECTED:UNDIRECTED);
+  DeltaCensus dc(&tg, motif_size, dir, &m_count);
+
+  printf("Subgraph Size: %d\n", motif_size);
+  printf("Graph File: %s\n", graph_file);
+  printf("%s, %d Nodes, %d Timed Edges (times %d to %d)\n", dir?"Directed":"Undirected",
+	 nodes, n, e[0].t, e[n-1].t);
+  printf("Windows of %d, every %d\n", window_size, window_step);
+  fprintf(f_output, "Subgraph Size: %d\nGraph File: \"%s\"\nWindow: %d\nStep: %d\nDirected: %s\n%s\n",
+	  motif_size, graph_file, window_size, window_step, dir?"YES":"NO", SEPARATOR);
+
+  int in = 0, out = 0;
+  Timer::start(0);
+  for (i=0, start=e[0].t; ; i++, start+=window_step) {
+
+    // Edges entering [start, start+window_size), then edges leaving
+    for (; in<n && e[in].t < start+window_size; in++) {
+      iPair p(e[in].a, e[in].b);
+      if (!dir && p.first>p.second) swap(p.first, p.second);
+      mult[p]++;
+      changed.push_back(p);
+    }
+    for (; out<in && e[out].t < start; out++) {
+      iPair p(e[out].a, e[out].b);
+      if (!dir && p.first>p.second) swap(p.first, p.second);
+      if (--mult[p]==0) mult.erase(p);
+      changed.push_back(p);
+    }
+
+    for (vector<iPair>::iterator ii=changed.begin(); ii!=changed.end(); ii++)
+      if (mult.count(*ii)) dc.addEdge(ii->first, ii->second);
+      else                 dc.rmEdge(ii->first, ii->second);
+    changed.clear();
+
+    Timer::stop(0);
+    fprintf(f_output, "Window %d: [%lld, %lld), %d edges, %.6fs\n", i, start, start+window_size,
+	    dir?tg.numEdges():tg.numEdges()/2, Timer::elapsed(0));
+    write_frequencies(&m_count);
+
+    if (start+window_size > e[n-1].t) break; // last edge is on this window
+  }
+
+  printf("%d windows in %.6fs\n", i+1, Timer::elapsed(0));
+  printf("Frequencies written to file \"%s\"\n", output_file);
+}
+
+// Sums of the estimates of the runs of '-m colorcoding' (colorings)
+// and of '-m randomwalk' (walkers)
+typedef struct {
+  map<string, double> sum;
+  map<string, double> sumsq;
+  double total;            // Colorful trees or classes visited (all runs)
+} EstimateJob;
+
+// Write the estimate of each class found on one run
+static void _writeEstimates(FILE *out, int size, double total, map<string, double> &est) {
+  int n = est.size();
+  map<string, double>::iterator ii;
+
+  fwrite(&total, sizeof(double), 1, out);
+  fwrite(&n, sizeof(int), 1, out);
+  for (ii=est.begin(); ii!=est.end(); ii++) {
+    fwrite(ii->first.c_str(), 1, size*size, out);
+    fwrite(&ii->second, sizeof(double), 1, out);
+  }
+}
+
+// Colorings [first, last), writing the colorful trees and the estimate
+// of each class found on each of them
+void CmdLine::_colorWork(int first, int last, FILE *out, void *arg) {
+  int i;
+  double trees;
+  map<string, double> est;
+  ColorCoding cc(g, motif_size);
+
+  for (i=first; i<last; i++) {
+    est.clear();
+    trees = cc.estimate(random_seed+i, color_samples, &est);
+    _writeEstimates(out, motif_size, trees, est);
+  }
+}
+
+// Walkers [first, last), writing the concentrations found by each of them
+void CmdLine::_walkWork(int first, int last, FILE *out, void *arg) {
+  int i, n;
+  map<string, double> conc;
+  RandomWalk rw(g, motif_size);
+
+  for (i=first; i<last; i++) {
+    conc.clear();
+    n = rw.walk(random_seed+i, walk_steps, &conc);
+    _writeEstimates(out, motif_size, n, conc);
+  }
+}
+
+void CmdLine::_estimateMerge(FILE *in, void *arg) {
+  EstimateJob *job = (EstimateJob *)arg;
+  int i, n;
+  double total, e;
+  char s[motif_size*motif_size+1];
+
+  s[motif_size*motif_size] = 0;
+  while (fread(&total, sizeof(double), 1, in)==1 && fread(&n, sizeof(int), 1, in)==1) {
+    job->total += total;
+    for (i=0; i<n; i++) {
+      if (fread(s, 1, motif_size*motif_size, in)!=(size_t)(motif_size*motif_size) ||
+	  fread(&e, sizeof(double), 1, in)!=1)
+	Error::msg("Incomplete estimation results");
+      job->sum[s]   += e;
+      job->sumsq[s] += e*e;
+    }
+  }
+}
+
+static bool _largerEstimate(const pair<double, string> &a, const pair<double, string> &b) {
+  return a.first > b.first;
+}
+
+// Estimate the frequencies (color coding) or concentrations (random walk)
+// of the original network, with runs on all jobs, and write them with
+// their deviation
+void CmdLine::compute_estimates() {
+  int i, r;
+  double mean, dev;
+  EstimateJob job;
+  map<string, double>::iterator ii;
+  vector<pair<double, string> > res;
+  bool color = (method == COLORCODING);
+
+  r = color ? color_number : walk_number;
+  if (color) {
+    printf("Method:     color coding, %d colorings of %d samples\n", color_number, color_samples);
+    printf("Estimating subgraph frequency on 'ORIGINAL NETWORK'\n");
+  } else {
+    printf("Method:     random walk, %d walkers of %d steps\n", walk_number, walk_steps);
+    printf("Estimating subgraph concentration on 'ORIGINAL NETWORK'\n");
+  }
+  job.total = 0;
+  Timer::start(0);
+  if (color) Parallel::run(r, _colorWork, _estimateMerge, &job);
+  else       Parallel::run(r, _walkWork,  _estimateMerge, &job);
+  Timer::stop(0);
+  if (color) printf("%d subgraphs, %.0f colorful trees per coloring\n", (int)job.sum.size(), job.total/r);
+  else       printf("%d subgraphs, %.1f visited per walker\n", (int)job.sum.size(), job.total/r);
+  printf("Time elapsed: %.6fs\n\n", Timer::elapsed(0));
+
+  for (ii=job.sum.begin(); ii!=job.sum.end(); ii++)
+    res.push_back(make_pair(ii->second/r, ii->first));
+  stable_sort(res.begin(), res.end(), _largerEstimate);
+
+  fprintf(f_output, "Subgraph Size: %d\nGraph File: \"%s\"\nDirected: %s\n", motif_size, graph_file, dir?"YES":"NO");
+  if (color)
+    fprintf(f_output, "Colorings: %d\nSamples: %d per coloring\n", color_number, color_samples);
+  else
+    fprintf(f_output, "Walkers: %d\nSteps: %d per walker\n", walk_number, walk_steps);
+  fprintf(f_output, "Random Seed: %d\nTime: %.6fs\n%s\n", random_seed, Timer::elapsed(0), SEPARATOR);
+  fprintf(f_output, "%-*s %16s %16s %10s\n", motif_size*motif_size, "Subgraph",
+	  color ? "Estimate" : "Concentration", "Deviation", "Rel. Error");
+  for (i=0; i<(int)res.size(); i++) {
+    mean = res[i].first;
+    dev  = r>1 ? sqrt(max(0.0, (job.sumsq[res[i].second] - r*mean*mean)/(r-1))) : 0;
+    fprintf(f_output, "%s %16.6g %16.6g %9.2f%%\n", res[i].second.c_str(), mean, dev,
+	    mean>0 ? 100*dev/sqrt((double)r)/mean : 0);
+  }
+  printf("Results written to file \"%s\"\n", output_file);
+}
+
+// Merge partial results of all partitions and output final results
+void CmdLine::merge_results() {
+  int i;
+  PartialHeader h, first;
+  vector<mapStringInt> m_count;
+  vector<bool> seen;
+  char graph[MAX_BUF];
+
+  if (merge_number == 0)
+    Error::msg("No partial results files to merge");
+  memset(&first, 0, sizeof(PartialHeader));
+
+  for (i=0; i<merge_number; i++) {
+    printf("Reading partial results \"%s\"\n", merge_files[i]);
+    Partition::readResults(merge_files[i], &h, graph, m_count);
+    if (i==0) {
+      first = h;
+      seen.resize(h.nparts, false);
+      strcpy(graph_file, graph);
+    } else {
+      if (h.motif_size != first.motif_size || h.dir != first.dir || h.method != first.method ||
+	  h.nodes != first.nodes || h.edges != first.edges || h.nparts != first.nparts ||
+	  h.random_number != first.random_number || h.random_seed != first.random_seed ||
+	  h.random_exchanges != first.random_exchanges || h.random_tries != first.random_tries ||
+	  h.order != first.order)
+	Error::msg("Partial results \"%s\" were computed with different parameters", merge_files[i]);
+      first.time_original = max(first.time_original, h.time_original);
+      first.time_random   = max(first.time_random, h.time_random);
+    }
+    if (h.part<0 || h.part>=h.nparts || seen[h.part])
+      Error::msg("Partition %d/%d given more than once", h.part, h.nparts);
+    seen[h.part] = true;
+  }
+  if (merge_number != first.nparts)
+    Error::msg("Only %d of %d partitions given", merge_number, first.nparts);
+
+  // Results are reported with the parameters of the partial computations
+  motif_size       = first.motif_size;
+  dir              = first.dir;
+  method           = (MethodType)first.method;
+  num_nodes        = first.nodes;
+  num_edges        = first.edges;
+  random_number    = first.random_number;
+  random_seed      = first.random_seed;
+  random_exchanges = first.random_exchanges;
+  random_tries     = first.random_tries;
+  time_original    = first.time_original;
+  time_random      = first.time_random;
+
+  prepare_files();
+  report_results(m_count);
+  printf("Results written to file \"%s\"\n", output_file);
 }
 
 // ----------------------------------------------
@@ -355,8 +1333,10 @@ void CmdLine::show_results(ResultType *res, int nres) {
   fprintf(f_output, "%sSubgraph Size:%s %d\n", html?"<li><b>":"", html?"</b>":"", motif_size);
   fprintf(f_output, "%sGraph File:%s \"%s\"\n", html?"<li><b>":"", html?"</b>":"",graph_file);
   fprintf(f_output, "%sDirected:%s %s\n", html?"<li><b>":"", html?"</b>":"",dir?"YES":"NO");
-  fprintf(f_output, "%sNr Nodes:%s %d\n", html?"<li><b>":"", html?"</b>":"",g->numNodes());
-  fprintf(f_output, "%sNr Edges:%s %d\n", html?"<li><b>":"", html?"</b>":"",dir?g->numEdges():g->numEdges()/2);
+  fprintf(f_output, "%sNr Nodes:%s %d\n", html?"<li><b>":"", html?"</b>":"", num_nodes);
+  fprintf(f_output, "%sNr Edges:%s %d\n", html?"<li><b>":"", html?"</b>":"", num_edges);
+  if (!seeds.empty())
+    fprintf(f_output, "%sSeeds:%s %d nodes from \"%s\"\n", html?"<li><b>":"", html?"</b>":"", (int)seeds.size(), seeds_file);
   
   if (html) fprintf(f_output, "<br>&nbsp;\n");
   else      fprintf(f_output, "\n");
@@ -368,9 +1348,24 @@ void CmdLine::show_results(ResultType *res, int nres) {
     fprintf(f_output, "GTRIE with file containing complete g-trie\n");
   else if (method == SUBGRAPHS)
     fprintf(f_output, "GTRIE with subgraphs read from file\n");
-
-  fprintf(f_output, "%sDifferent Types of Subgraphs Found [Original Network]:%s %d\n", html?"<li><b>":"", html?"</b>":"", sg_original.countGraphs());
-  fprintf(f_output, "%sSubgraph Occurrences Found [Original Network]:%s %.0f\n", html?"<li><b>":"", html?"</b>":"", sg_original.countOccurrences());
+  else if (method == COMPLETE)
+    fprintf(f_output, "GTRIE with all subgraphs (generated)\n");
+  else if (method == HYBRID)
+    fprintf(f_output, "GTRIE with subgraphs found by sampling\n");
+  else if (method == TRIADS)
+    fprintf(f_output, "Triad census in closed form\n");
+  else if (method == GRAPHLETS)
+    fprintf(f_output, "Graphlet equations\n");
+
+  int    found = 0;
+  double total = 0;
+  for (i=0; i<nres; i++)
+    if (res[i].f_original > 0) {
+      found++;
+      total += res[i].f_original;
+    }
+  fprintf(f_output, "%sDifferent Types of Subgraphs Found [Original Network]:%s %d\n", html?"<li><b>":"", html?"</b>":"", found);
+  fprintf(f_output, "%sSubgraph Occurrences Found [Original Network]:%s %.0f\n", html?"<li><b>":"", html?"</b>":"", total);
   fprintf(f_output, "%sTime for computing census on original network%s: %.6fs\n", html?"<li><b>":"", html?"</b>":"", time_original);
   fprintf(f_output, "%sAverage time for census on random network%s: %.6fs\n", html?"<li><b>":"", html?"</b>":"", time_random);
 
@@ -421,17 +1416,35 @@ void CmdLine::decide_action() {
 
   t_start = time(0);
 
-  if (create) {
+  if (daemon) {
+    run_daemon();
+  } else if (merge) {
+    merge_results();
+  } else if (create) {
     create_gtrie();
+  } else if (convert) {
+    convert_gtrie();
+  } else if (strcmp(query_file, INVALID_FILE)) {
+    query_index();
+  } else if (window_size > 0) {
+    prepare_files();
+    compute_temporal();
   } else {
       // Check method
       if (method == NOMETHOD)
 	Error::msg("No valid method specified");    
       
       prepare_graph();
-      prepare_files();
-      compute_original();
-      compute_results();
+      if (method == COLORCODING || method == RANDOMWALK) {
+	prepare_files();
+	compute_estimates();
+      } else {
+	prepare_checkpoint();
+	prepare_files();
+	compute_original();
+	if (strcmp(stream_file, INVALID_FILE)) compute_stream();
+	else compute_results();
+      }
   }
 
 }
@@ -440,18 +1453,32 @@ void CmdLine::decide_action() {
 
 // Initialize everything
 void CmdLine::init(int argc, char **argv) {
+
+  // Requests to a daemon are run there (output included)
+  for (int i=1; i<argc-1; i++)
+    if (!strcmp("-cl",argv[i]) || !strcmp("--client",argv[i]))
+      exit(run_client(argc, argv, i));
+
   about();
   defaults();
   parse_cmdargs(argc, argv);
+  configure();
+}
+
+// Set up the modules with the parsed options
+void CmdLine::configure() {
+  SetOps::init(setops);
+  Parallel::setJobs(jobs);
   Isomorphism::initNauty(motif_size, dir);
 }
 
 // Finish everything
 void CmdLine::finish() { 
-  if (!create) {
-    fclose(f_output);
-    if (occurrences) fclose(f_occ);
-  }
+  if (f_output!=NULL) fclose(f_output);
+  if (f_occ!=NULL) fclose(f_occ);
+  Checkpoint::close();
+  if (Global::labels!=NULL) {delete[] Global::labels; Global::labels = NULL;}
+  if (Global::names!=NULL) {delete Global::names; Global::names = NULL;}
   Isomorphism::finishNauty();
 }
 
@@ -475,16 +1502,55 @@ void CmdLine::defaults() {
 
   strcpy(output_file, DEFAULT_RESULTS);
   strcpy(occ_file, DEFAULT_OCC);
+  strcpy(index_file, INVALID_FILE);
+  strcpy(orbit_file, INVALID_FILE);
+  strcpy(query_file, INVALID_FILE);
+  query_class[0] = query_node[0] = 0;
 
   random_number    = 0;
   random_seed      = time(0);
   random_exchanges = 3;
   random_tries     = 10;
 
+  jobs = 1;
+  workers = DAEMON_DEFAULT_WORKERS;
+  daemon = false;
   create = false;
+  convert = false;
+  binary = false;
   format = SIMPLE_WEIGHT;
+  order  = NATURAL;
+  setops = SETOPS_AUTO;
   output = TEXT;
   occurrences = false;
+
+  f_output = f_occ = NULL;
+  g = NULL;
+  gt = gt_original = NULL;
+  Global::labels = NULL;
+  Global::names = NULL;
+  name_index.clear();
+  intersect = false;
+  delta = false;
+
+  partition = partition_number = 0;
+  merge = false;
+  merge_number = 0;
+
+  strcpy(checkpoint_file, INVALID_FILE);
+  strcpy(stream_file, INVALID_FILE);
+  strcpy(seeds_file, INVALID_FILE);
+  seeds.clear();
+  stream_batch = STREAM_DEFAULT_BATCH;
+  window_size = window_step = 0;
+  Generator::defaultCacheDir(cache_dir);
+  hybrid_sample = HYBRID_DEFAULT_SAMPLE;
+  color_number  = COLOR_DEFAULT_COLORINGS;
+  color_samples = COLOR_DEFAULT_SAMPLES;
+  walk_number   = WALK_DEFAULT_WALKERS;
+  walk_steps    = WALK_DEFAULT_STEPS;
+  checkpoint_interval = CHECKPOINT_DEFAULT_INTERVAL;
+  resume = false;
 }
 
 // ----------------------------------------------
@@ -494,6 +1560,12 @@ MethodType CmdLine::str_to_method(char *s) {
   if      (!strcmp(s, "esu"))       return ESU;
   else if (!strcmp(s, "gtrie"))     return GTRIE;
   else if (!strcmp(s, "subgraphs")) return SUBGRAPHS;
+  else if (!strcmp(s, "complete"))  return COMPLETE;
+  else if (!strcmp(s, "hybrid"))    return HYBRID;
+  else if (!strcmp(s, "colorcoding")) return COLORCODING;
+  else if (!strcmp(s, "randomwalk"))  return RANDOMWALK;
+  else if (!strcmp(s, "triads"))    return TRIADS;
+  else if (!strcmp(s, "graphlets")) return GRAPHLETS;
   else return NOMETHOD;
 }
 
@@ -504,6 +1576,27 @@ FormatType CmdLine::str_to_format(char *s) {
   else return NOFORMAT;
 }
 
+// Convert string to node order type
+OrderType CmdLine::str_to_order(char *s) {
+  if      (!strcmp(s, "natural"))     return NATURAL;
+  else if (!strcmp(s, "degree"))      return DEGREE;
+  else if (!strcmp(s, "degree_desc")) return DEGREE_DESC;
+  else if (!strcmp(s, "degeneracy"))  return DEGENERACY;
+  else if (!strcmp(s, "bfs"))         return BFS;
+  else if (!strcmp(s, "rcm"))         return RCM;
+  else return NOORDER;
+}
+
+// Convert string to set operations kernel type
+SetOpsType CmdLine::str_to_setops(char *s) {
+  if      (!strcmp(s, "auto"))   return SETOPS_AUTO;
+  else if (!strcmp(s, "scalar")) return SETOPS_SCALAR;
+  else if (!strcmp(s, "sse"))    return SETOPS_SSE;
+  else if (!strcmp(s, "avx2"))   return SETOPS_AVX2;
+  else Error::msg("Invalid set operations kernel \"%s\"", s);
+  return SETOPS_AUTO;
+}
+
 // Convert string to graph format type
 OutputType CmdLine::str_to_output(char *s) {
   if      (!strcmp(s, "txt"))  return TEXT;
@@ -513,7 +1606,9 @@ OutputType CmdLine::str_to_output(char *s) {
 
 // Parse all command line arguments
 void CmdLine::parse_cmdargs(int argc, char **argv) {
-    
+  bool seed_given = false;
+  bool method_given = false;
+
   for (int i=1; i<argc; i++) {
 
     // Create g-trie ?
@@ -521,6 +1616,64 @@ void CmdLine::parse_cmdargs(int argc, char **argv) {
       create=true;
       strcpy(subgraphs_file, argv[++i]);
     }
+
+    // Write created g-trie in binary ?
+    else if (!strcmp("-bi",argv[i]) || !strcmp("--binary",argv[i])) {
+      binary=true;
+    }
+
+    // Colorings and trees sampled on each by the color coding method
+    else if (!strcmp("-cn",argv[i]) || !strcmp("--colorings",argv[i])) {
+      color_number = atoi(argv[++i]);
+      if (color_number<1) Error::msg("Invalid number of colorings (must be at least 1)");
+    }
+    else if (!strcmp("-cs",argv[i]) || !strcmp("--csamples",argv[i])) {
+      color_samples = atoi(argv[++i]);
+      if (color_samples<1) Error::msg("Invalid number of samples (must be at least 1)");
+    }
+    else if (!strcmp("-wn",argv[i]) || !strcmp("--walkers",argv[i])) {
+      walk_number = atoi(argv[++i]);
+      if (walk_number<1) Error::msg("Invalid number of walkers (must be at least 1)");
+    }
+    else if (!strcmp("-ws",argv[i]) || !strcmp("--wsteps",argv[i])) {
+      walk_steps = atoi(argv[++i]);
+      if (walk_steps<1) Error::msg("Invalid number of steps (must be at least 1)");
+    }
+
+    // Fraction of subgraphs sampled by the hybrid method
+    else if (!strcmp("-hs",argv[i]) || !strcmp("--hsample",argv[i])) {
+      hybrid_sample = atof(argv[++i]);
+      if (hybrid_sample<=0 || hybrid_sample>1) Error::msg("Invalid sampling fraction (must be in ]0,1])");
+    }
+
+    // Directory of cached g-tries
+    else if (!strcmp("-cd",argv[i]) || !strcmp("--cachedir",argv[i])) {
+      strcpy(cache_dir, argv[++i]);
+    }
+
+    // Serve requests on a socket
+    else if (!strcmp("-dm",argv[i]) || !strcmp("--daemon",argv[i])) {
+      daemon = true;
+      strcpy(daemon_socket, argv[++i]);
+    }
+
+    // Requests run at the same time by the daemon
+    else if (!strcmp("-dw",argv[i]) || !strcmp("--workers",argv[i])) {
+      workers = atoi(argv[++i]);
+      if (workers<1) Error::msg("Invalid number of workers (must be at least 1)");
+    }
+
+    // Number of processes
+    else if (!strcmp("-j",argv[i]) || !strcmp("--jobs",argv[i])) {
+      jobs = atoi(argv[++i]);
+      if (jobs<1) Error::msg("Invalid number of jobs (must be at least 1)");
+    }
+
+    // Convert g-trie file ?
+    else if (!strcmp("-cv",argv[i]) || !strcmp("--convert",argv[i])) {
+      convert=true;
+      strcpy(gtrie_file, argv[++i]);
+    }
     
     // Graph file
     else if (!strcmp("-g",argv[i]) || !strcmp("--graph",argv[i])) {
@@ -538,6 +1691,27 @@ void CmdLine::parse_cmdargs(int argc, char **argv) {
       strcpy(occ_file, argv[++i]);
     }
 
+    // Index of occurrences
+    else if (!strcmp("-oi",argv[i]) || !strcmp("--occindex",argv[i])) {
+      strcpy(index_file, argv[++i]);
+    }
+
+    // Orbits of each node (-m graphlets)
+    else if (!strcmp("-ob",argv[i]) || !strcmp("--orbits",argv[i])) {
+      strcpy(orbit_file, argv[++i]);
+    }
+
+    // Query an index of occurrences
+    else if (!strcmp("-q",argv[i]) || !strcmp("--query",argv[i])) {
+      strcpy(query_file, argv[++i]);
+    }
+    else if (!strcmp("-qc",argv[i]) || !strcmp("--qclass",argv[i])) {
+      strcpy(query_class, argv[++i]);
+    }
+    else if (!strcmp("-qn",argv[i]) || !strcmp("--qnode",argv[i])) {
+      strcpy(query_node, argv[++i]);
+    }
+
     // Output format
     else if (!strcmp("-t",argv[i]) || !strcmp("--type",argv[i])) {
       output = str_to_output(argv[++i]);
@@ -551,6 +1725,7 @@ void CmdLine::parse_cmdargs(int argc, char **argv) {
     // Method for set of subgraphs
     else if (!strcmp("-m",argv[i]) || !strcmp("--method",argv[i])) {
       method = str_to_method(argv[++i]);
+      method_given = true;
       if (method == SUBGRAPHS) strcpy(subgraphs_file, argv[++i]);
       else if (method == GTRIE) strcpy(gtrie_file, argv[++i]);
     }
@@ -559,6 +1734,21 @@ void CmdLine::parse_cmdargs(int argc, char **argv) {
     else if (!strcmp("-f",argv[i]) || !strcmp("--format",argv[i])) {
       format = str_to_format(argv[++i]);
     }
+
+    // Intersect neighbours on g-trie census
+    else if (!strcmp("-ix",argv[i]) || !strcmp("--intersect",argv[i])) {
+      intersect = true;
+    }
+
+    // Set operations kernels
+    else if (!strcmp("-so",argv[i]) || !strcmp("--setops",argv[i])) {
+      setops = str_to_setops(argv[++i]);
+    }
+
+    // Node order
+    else if (!strcmp("-or",argv[i]) || !strcmp("--order",argv[i])) {
+      order = str_to_order(argv[++i]);
+    }
     
     // Directed Graph
     else if (!strcmp("-d",argv[i]) || !strcmp("--directed",argv[i])) {
@@ -578,6 +1768,40 @@ void CmdLine::parse_cmdargs(int argc, char **argv) {
     // Random seed
     else if (!strcmp("-rs",argv[i]) || !strcmp("--rseed",argv[i])) {
       random_seed = atoi(argv[++i]);
+      seed_given = true;
+    }
+
+    // Update frequencies on each swap instead of a census per random network
+    else if (!strcmp("-dc",argv[i]) || !strcmp("--delta",argv[i])) {
+      delta = true;
+    }
+
+    // Only count subgraphs with seeds
+    else if (!strcmp("-sd",argv[i]) || !strcmp("--seeds",argv[i])) {
+      strcpy(seeds_file, argv[++i]);
+    }
+
+    // Log of edge updates
+    else if (!strcmp("-st",argv[i]) || !strcmp("--stream",argv[i])) {
+      strcpy(stream_file, argv[++i]);
+    }
+
+    // Updates per batch
+    else if (!strcmp("-sb",argv[i]) || !strcmp("--sbatch",argv[i])) {
+      stream_batch = atoi(argv[++i]);
+      if (stream_batch<1) Error::msg("Invalid batch size (must be at least 1)");
+    }
+
+    // Window of temporal mode
+    else if (!strcmp("-tw",argv[i]) || !strcmp("--twindow",argv[i])) {
+      window_size = atoi(argv[++i]);
+      if (window_size<1) Error::msg("Invalid window size (must be at least 1)");
+    }
+
+    // Time between windows
+    else if (!strcmp("-tt",argv[i]) || !strcmp("--tstep",argv[i])) {
+      window_step = atoi(argv[++i]);
+      if (window_step<1) Error::msg("Invalid window step (must be at least 1)");
     }
 
     // Number of exchanges per edge
@@ -590,6 +1814,121 @@ void CmdLine::parse_cmdargs(int argc, char **argv) {
       random_tries = atoi(argv[++i]);
     }
 
+    // Checkpoint file
+    else if (!strcmp("-cp",argv[i]) || !strcmp("--checkpoint",argv[i])) {
+      strcpy(checkpoint_file, argv[++i]);
+    }
+
+    // Seconds between checkpoints
+    else if (!strcmp("-ci",argv[i]) || !strcmp("--cpinterval",argv[i])) {
+      checkpoint_interval = atoi(argv[++i]);
+    }
+
+    // Resume from checkpoint
+    else if (!strcmp("-cr",argv[i]) || !strcmp("--resume",argv[i])) {
+      resume = true;
+    }
+
+    // Only count one partition of the root nodes
+    else if (!strcmp("-pa",argv[i]) || !strcmp("--partition",argv[i])) {
+      if (!Partition::parse(argv[++i], &partition, &partition_number))
+	Error::msg("Invalid partition \"%s\" (should be i/N, with 0 <= i < N)", argv[i]);
+    }
+
+    // Merge partial results (all files until next option)
+    else if (!strcmp("-mg",argv[i]) || !strcmp("--merge",argv[i])) {
+      merge = true;
+      merge_files = &argv[i+1];
+      while (i+1<argc && argv[i+1][0]!='-') {
+	merge_number++;
+	i++;
+      }
+    }
+
+  }
+
+  // Without '-m', undirected size 4 uses the graphlet equations
+  // (when the subgraphs themselves are not needed)
+  if (!method_given && !occurrences && !strcmp(index_file, INVALID_FILE) &&
+      !strcmp(seeds_file, INVALID_FILE) && partition_number==0 && !strcmp(checkpoint_file, INVALID_FILE) &&
+      motif_size==4 && !dir)
+    method = GRAPHLETS;
+
+  // All partitions must generate the same random networks
+  if (partition_number>0 && random_number>0 && !seed_given)
+    Error::msg("A random seed (-rs) must be given when using partitions");
+
+  // Each partition would only count on the random networks the subgraphs it sampled
+  if (method == HYBRID && partition_number>0 && random_number>0)
+    Error::msg("Hybrid method can not be used with partitions and random networks");
+
+  // Delta census only follows the whole network
+  if (delta && (partition_number>0 || strcmp(checkpoint_file, INVALID_FILE)))
+    Error::msg("Delta census (-dc) can not be used with partitions or checkpoints");
+  if (delta && motif_size>DELTA_MAX_SIZE)
+    Error::msg("Delta census (-dc) only supports sizes up to %d", DELTA_MAX_SIZE);
+
+  // Frequencies of incremental modes are of the whole graph
+  if (strcmp(seeds_file, INVALID_FILE) && (delta || strcmp(stream_file, INVALID_FILE) || window_size>0))
+    Error::msg("Seeds (-sd) can not be used with -dc, -st or -tw");
+
+  // Streaming only follows the updated graph
+  if (strcmp(stream_file, INVALID_FILE)) {
+    if (random_number>0 || partition_number>0 || strcmp(checkpoint_file, INVALID_FILE))
+      Error::msg("Streaming (-st) can not be used with random networks, partitions or checkpoints");
+    if (motif_size>DELTA_MAX_SIZE)
+      Error::msg("Streaming (-st) only supports sizes up to %d", DELTA_MAX_SIZE);
+  }
+
+  // Color coding only estimates the frequencies on the original network
+  if (method == COLORCODING) {
+    if (random_number>0 || partition_number>0 || strcmp(checkpoint_file, INVALID_FILE) ||
+	strcmp(stream_file, INVALID_FILE) || strcmp(seeds_file, INVALID_FILE) ||
+	occurrences || strcmp(index_file, INVALID_FILE) || window_size>0)
+      Error::msg("Color coding can not be used with random networks, partitions, checkpoints, streams, seeds, occurrences or temporal mode");
+    if (motif_size>COLOR_MAX_SIZE)
+      Error::msg("Color coding only supports sizes up to %d", COLOR_MAX_SIZE);
+  }
+
+  // Random walks only estimate the concentrations on the original network
+  if (method == RANDOMWALK) {
+    if (random_number>0 || partition_number>0 || strcmp(checkpoint_file, INVALID_FILE) ||
+	strcmp(stream_file, INVALID_FILE) || strcmp(seeds_file, INVALID_FILE) ||
+	occurrences || strcmp(index_file, INVALID_FILE) || window_size>0)
+      Error::msg("Random walk can not be used with random networks, partitions, checkpoints, streams, seeds, occurrences or temporal mode");
+    if (motif_size<2)
+      Error::msg("Random walk needs subgraphs of at least 2 nodes");
+  }
+
+  // The triad census counts subgraphs without finding them
+  if (method == TRIADS) {
+    if (partition_number>0 || strcmp(checkpoint_file, INVALID_FILE) || strcmp(seeds_file, INVALID_FILE) ||
+	occurrences || strcmp(index_file, INVALID_FILE))
+      Error::msg("Triad census can not be used with partitions, checkpoints, seeds or occurrences");
+    if (motif_size!=3)
+      Error::msg("Triad census only counts subgraphs of size 3");
+  }
+
+  // Graphlet equations count subgraphs without finding them (orbits only with them)
+  if (method == GRAPHLETS) {
+    if (partition_number>0 || strcmp(checkpoint_file, INVALID_FILE) || strcmp(seeds_file, INVALID_FILE) ||
+	occurrences || strcmp(index_file, INVALID_FILE))
+      Error::msg("Graphlet equations can not be used with partitions, checkpoints, seeds or occurrences");
+    if (motif_size!=4 || dir)
+      Error::msg("Graphlet equations only count undirected subgraphs of size 4");
+  } else if (strcmp(orbit_file, INVALID_FILE))
+    Error::msg("Orbits (-ob) are only counted by the graphlet equations (-m graphlets)");
+
+  // The index is built from all the occurrences at the end of the census
+  if (strcmp(index_file, INVALID_FILE) && strcmp(checkpoint_file, INVALID_FILE))
+    Error::msg("Occurrence index (-oi) can not be used with checkpoints");
+
+  // Temporal mode counts each window (by default windows do not overlap)
+  if (window_size>0) {
+    if (random_number>0 || partition_number>0 || strcmp(checkpoint_file, INVALID_FILE) ||
+	strcmp(stream_file, INVALID_FILE))
+      Error::msg("Temporal mode (-tw) can not be used with random networks, partitions, checkpoints or streams");
+    if (window_step==0) window_step = window_size;
   }
 
   // If no random seed given, initialize with time
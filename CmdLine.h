@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Command Line Client functions
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #ifndef _CMDLINE_
@@ -29,6 +29,39 @@ Last Update: 11/02/2012
 #include "Isomorphism.h"
 #include "Timer.h"
 #include "Random.h"
+#include "Checkpoint.h"
+#include "Partition.h"
+#include "SetOps.h"
+#include "Parallel.h"
+#include "Generator.h"
+#include "Daemon.h"
+#include "DeltaCensus.h"
+#include "OccIndex.h"
+#include "ColorCoding.h"
+#include "RandomWalk.h"
+#include "Triads.h"
+#include "Graphlets.h"
+
+#define HYBRID_DEFAULT_SAMPLE 0.1 // Fraction of subgraphs sampled by '-m hybrid'
+#define STREAM_DEFAULT_BATCH 1000 // Updates between snapshots of '-st'
+#define COLOR_DEFAULT_COLORINGS 10     // Colorings of '-m colorcoding'
+#define COLOR_DEFAULT_SAMPLES   100000 // Trees sampled on each coloring
+#define WALK_DEFAULT_WALKERS 10         // Walkers of '-m randomwalk'
+#define WALK_DEFAULT_STEPS   100000     // Steps of each walker
+
+// Graph kept by the daemon between requests
+typedef struct {
+  long long mtime;  // Modification time of the file when read
+  Graph *g;
+  int *labels;      // Original labels (see Global::labels)
+  vector<string> *names; // Identifiers of the labels (see Global::names)
+} CachedGraph;
+
+// G-Trie kept by the daemon between requests
+typedef struct {
+  long long mtime;
+  GTrie *gt;
+} CachedGTrie;
 
 class CmdLine {
  private:
@@ -37,22 +70,57 @@ class CmdLine {
   static char subgraphs_file[MAX_BUF];
   static char output_file[MAX_BUF];
   static char occ_file[MAX_BUF];
+  static char index_file[MAX_BUF];
+  static char orbit_file[MAX_BUF];
+  static char query_file[MAX_BUF];
+  static char query_class[MAX_BUF]; // Class and node of a query ("": all)
+  static char query_node[MAX_BUF];
+  static char checkpoint_file[MAX_BUF];
+  static char stream_file[MAX_BUF];
+  static char seeds_file[MAX_BUF];
+  static char cache_dir[MAX_BUF];
+  static char daemon_socket[MAX_BUF];
 
   static bool dir;
   static bool occurrences;
   static bool create;
+  static bool convert;
+  static bool binary;
+  static bool resume;
+  static bool merge;
+  static bool daemon;
+  static bool intersect;
+  static bool delta;
 
   static int motif_size;
   static int random_number;
   static int random_seed;
   static int random_exchanges;
   static int random_tries;
+  static int checkpoint_interval;
+  static int jobs;
+  static int stream_batch;
+  static int color_number;
+  static int color_samples;
+  static int walk_number;
+  static int walk_steps;
+  static int window_size;
+  static int window_step;
+  static int workers;
+  static int partition;
+  static int partition_number;
+  static int num_nodes;
+  static int num_edges;
+
+  static double hybrid_sample;
 
   static double time_original;
   static double time_random;
 
   static MethodType method;
   static FormatType format;
+  static OrderType order;
+  static SetOpsType setops;
   static OutputType output;
   static Graph *g;
 
@@ -64,28 +132,77 @@ class CmdLine {
 
   static GraphTree sg_original;
 
+  static vector<int> seeds;     // Only count subgraphs with one of these nodes
+  static vector<int> seed_dist; // Distance of each node to the seeds
+
+  static map<string, int> name_index; // Label of each identifier (see Global::names)
+
   static time_t t_start;
+
+  static char **merge_files;
+  static int merge_number;
+
+  static map<string, CachedGraph> graph_cache;
+  static map<string, CachedGTrie> gtrie_cache;
   
   static void about();
   static void defaults();
+  static void configure();
   static void parse_cmdargs(int argc, char **argv);
   static void run_esu(Graph *g, GraphTree *sg);
   static void run_gtrie(Graph *g, GraphTree *sg);
   static void run_subgraphs(Graph *g, GraphTree *sg);
+  static void run_complete(Graph *g, GraphTree *sg);
+  static void run_hybrid(Graph *g, GraphTree *sg);
+  static void _hybridWork(int first, int last, FILE *out, void *arg);
+  static void _hybridMerge(FILE *in, void *arg);
+  static void run_triads(Graph *g, GraphTree *sg);
+  static void run_graphlets(Graph *g, GraphTree *sg, bool orbits);
+  static void write_orbits(Graph *g, const long long *orbits);
+  static void run_census(GTrie *t, Graph *g, int phase);
+  static void census_progress(int next, GTrie *t);
 
   static MethodType str_to_method(char *s);
   static FormatType str_to_format(char *s);
+  static OrderType str_to_order(char *s);
+  static SetOpsType str_to_setops(char *s);
   static OutputType str_to_output(char *s);
 
   static int compare_results(const void *a, const void *b);
 
   static void prepare_graph();
+  static void load_graph();
+  static void read_seeds();
+  static int  file_node(const char *s, bool add);
+  static const int *seed_distances(Graph *g);
   static void prepare_files();
+  static void prepare_checkpoint();
   static void compute_original();
   static void compute_results();
+  static void count_random(int phase, mapStringInt *m);
+  static void report_results(vector<mapStringInt> &m_count);
+  static void compute_stream();
+  static int  read_updates(FILE *f, int max, int *node, map<iPair, bool> *batch);
+  static void grow_graph(int nodes);
+  static void write_frequencies(mapStringInt *m);
+  static void compute_temporal();
+  static void compute_estimates();
+  static void _colorWork(int first, int last, FILE *out, void *arg);
+  static void _walkWork(int first, int last, FILE *out, void *arg);
+  static void _estimateMerge(FILE *in, void *arg);
+  static void merge_results();
   static void show_results(ResultType *res, int nres);
 
   static void create_gtrie();
+  static void convert_gtrie();
+  static void query_index();
+
+  static Graph *cached_graph();
+  static GTrie *cached_gtrie(char *s);
+  static bool daemon_prepare(int argc, char **argv);
+  static void daemon_run();
+  static void run_daemon();
+  static int  run_client(int argc, char **argv, int pos);
 
  public:
   static void init(int argc, char **argv);
@@ -0,0 +1,218 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Color coding estimates of subgraph frequencies
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "ColorCoding.h"
+#include "Isomorphism.h"
+#include "Random.h"
+#include <cmath>
+
+ColorCoding::ColorCoding(Graph *g, int size) {
+  int i;
+
+  _g    = g;
+  _size = size;
+  _n    = g->numNodes();
+  _color = new int[_n];
+  _count = new double[(long long)_n<<(size-1)];
+  _sum   = new double[(long long)_n<<(size-1)];
+  _roots = new double[_n+1];
+  _bySize = new vector<int>[size+1];
+  for (i=0; i<(1<<size); i++)
+    _bySize[__builtin_popcount(i)].push_back(i);
+}
+
+ColorCoding::~ColorCoding() {
+  delete[] _color;
+  delete[] _count;
+  delete[] _sum;
+  delete[] _roots;
+  delete[] _bySize;
+}
+
+// Position of color set 'set' on the tables of node 'v' (without its color)
+int ColorCoding::_index(int v, int set) {
+  int c = _color[v];
+  return (set & ((1<<c)-1)) | ((set >> (c+1)) << c);
+}
+
+// c(v, C) and S(v, C) of all nodes, by increasing number of colors
+void ColorCoding::_countTrees() {
+  int i, j, s, v, set, rest, sub, m, own, num, *nei;
+  int full = (1<<_size)-1;
+  double total;
+
+  memset(_count, 0, sizeof(double)*((long long)_n<<(_size-1)));
+  memset(_sum,   0, sizeof(double)*((long long)_n<<(_size-1)));
+  for (v=0; v<_n; v++) {
+    _c(v, 1<<_color[v]) = 1;
+    nei = _g->arrayNeighbours(v);
+    num = _g->numNeighbours(v);
+    for (j=0; j<num; j++)
+      if (_color[nei[j]] != _color[v]) _s(v, 1<<_color[nei[j]]) += 1;
+  }
+
+  for (s=2; s<=_size; s++) {
+    for (v=0; v<_n; v++) {
+      own = 1<<_color[v];
+      for (i=0; i<(int)_bySize[s].size(); i++) {
+	set = _bySize[s][i];
+	if (!(set & own)) continue;
+	rest = set ^ own;
+	m = rest & -rest;
+	rest ^= m;
+	total = 0;
+	for (sub=rest; ; sub=(sub-1)&rest) {
+	  total += _s(v, sub|m) * _c(v, set^(sub|m));
+	  if (sub==0) break;
+	}
+	_c(v, set) = total;
+      }
+    }
+    if (s==_size) break;
+
+    for (v=0; v<_n; v++) {
+      own = 1<<_color[v];
+      nei = _g->arrayNeighbours(v);
+      num = _g->numNeighbours(v);
+      for (i=0; i<(int)_bySize[s].size(); i++) {
+	set = _bySize[s][i];
+	if (set & own) continue;
+	total = 0;
+	for (j=0; j<num; j++)
+	  if (set & (1<<_color[nei[j]])) total += _c(nei[j], set);
+	_s(v, set) = total;
+      }
+    }
+  }
+
+  _roots[0] = 0;
+  for (v=0; v<_n; v++) _roots[v+1] = _roots[v] + _c(v, full);
+}
+
+// Add to 'nodes' those of a uniform tree rooted at 'v' with the colors of 'set'
+void ColorCoding::_sample(int v, int set, int *nodes, int *n) {
+  int j, u, rest, sub, m, sel, num, *nei;
+  double r, w, acc;
+  int own = 1<<_color[v];
+
+  if (set == own) {
+    nodes[(*n)++] = v;
+    return;
+  }
+
+  // Colors of the subtree of the child with the smallest color
+  rest = set ^ own;
+  m = rest & -rest;
+  rest ^= m;
+  r = Random::getDouble() * _c(v, set);
+  acc = 0;
+  sel = -1;
+  for (sub=rest; ; sub=(sub-1)&rest) {
+    w = _s(v, sub|m) * _c(v, set^(sub|m));
+    if (w > 0) {
+      sel = sub|m;
+      acc += w;
+      if (acc > r) break;
+    }
+    if (sub==0) break;
+  }
+
+  // That child
+  nei = _g->arrayNeighbours(v);
+  num = _g->numNeighbours(v);
+  r = Random::getDouble() * _s(v, sel);
+  acc = 0;
+  u = -1;
+  for (j=0; j<num; j++)
+    if ((sel & (1<<_color[nei[j]])) && (w = _c(nei[j], sel)) > 0) {
+      u = nei[j];
+      acc += w;
+      if (acc > r) break;
+    }
+
+  _sample(u, sel, nodes, n);
+  _sample(v, set^sel, nodes, n);
+}
+
+// Number of spanning trees of the subgraph induced by 'nodes' (ignoring
+// direction), by the matrix tree theorem
+double ColorCoding::_spanningTrees(int *nodes) {
+  int i, j, l, p, k = _size-1;
+  double a[_size][_size], det = 1, f;
+
+  for (i=0; i<_size; i++) {
+    a[i][i] = 0;
+    for (j=0; j<_size; j++)
+      if (i!=j) {
+	a[i][j] = (_g->hasEdge(nodes[i], nodes[j]) || _g->hasEdge(nodes[j], nodes[i])) ? -1 : 0;
+	a[i][i] -= a[i][j];
+      }
+  }
+
+  // Determinant of the laplacian without its last row and column
+  for (i=0; i<k; i++) {
+    for (p=i, j=i+1; j<k; j++)
+      if (fabs(a[j][i]) > fabs(a[p][i])) p = j;
+    if (fabs(a[p][i]) < EPSILON) return 0;
+    if (p != i) {
+      for (l=0; l<k; l++) swap(a[i][l], a[p][l]);
+      det = -det;
+    }
+    det *= a[i][i];
+    for (j=i+1; j<k; j++) {
+      f = a[j][i] / a[i][i];
+      for (l=i; l<k; l++) a[j][l] -= f*a[i][l];
+    }
+  }
+  return floor(det+0.5);
+}
+
+double ColorCoding::estimate(int s, int samples, map<string, double> *est) {
+  int i, v, n, full = (1<<_size)-1;
+  int nodes[_size];
+  char str[_size*_size+1];
+  double rooted, trees, colorful = 1;
+  map<string, int> found;
+  map<string, int>::iterator ii;
+
+  Random::seed(s);
+  for (v=0; v<_n; v++) _color[v] = Random::getInteger(0, _size-1);
+  _countTrees();
+
+  rooted = _roots[_n];
+  if (rooted == 0) return 0;
+  trees = rooted / _size; // each tree has one root per node
+  for (i=1; i<=_size; i++) colorful *= (double)i/_size;
+
+  for (i=0; i<samples; i++) {
+    v = upper_bound(_roots, _roots+_n+1, Random::getDouble()*rooted) - _roots - 1;
+    if (v >= _n) v = _n-1;
+    while (_c(v, full) == 0) v--;
+
+    n = 0;
+    _sample(v, full, nodes, &n);
+    Isomorphism::canonicalStrNauty(_g, nodes, str);
+    if (found[str]++ == 0 && _spanning.find(str) == _spanning.end())
+      _spanning[str] = _spanningTrees(nodes);
+  }
+
+  for (ii=found.begin(); ii!=found.end(); ii++)
+    (*est)[ii->first] += trees * ii->second / ((double)samples * _spanning[ii->first]) / colorful;
+  return trees;
+}
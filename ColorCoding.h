@@ -0,0 +1,74 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Color coding estimates of subgraph frequencies
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _COLORCODING_
+#define _COLORCODING_
+
+#include "Common.h"
+#include "Graph.h"
+
+#define COLOR_MAX_SIZE 16 // Color sets are bitmasks (tables have 2^(SIZE-1) entries per node)
+
+// Estimates the frequencies of the k-subgraphs of a graph by color coding:
+// nodes get one of k random colors, the colorful trees (k nodes of
+// distinct colors) are counted by dynamic programming, and a uniform sample
+// of them is taken. Each sampled tree gives the subgraph induced by its
+// nodes, which is found once for each of its spanning trees. So, with T
+// colorful trees and S samples, a class with t spanning trees sampled s
+// times has about T*s/(S*t) colorful occurrences, and k^k/k! times that
+// occurrences (the chance of an occurrence being colorful is k!/k^k).
+//
+// Trees are counted by their root: c(v, C) is the number of trees rooted
+// at v with the colors of C. Each of them is split, uniquely, into the
+// subtree of the child with the smallest color of C (other than the color
+// of v) and the remaining tree (still rooted at v), so
+//   c(v, C) = sum over C' of S(v, C') * c(v, C - C')
+// for the C' of C without the color of v that have the smallest other
+// color, where S(v, C') is the sum of c(u, C') over the neighbours u of v.
+// Edge direction is ignored for the trees (not for the classes).
+class ColorCoding {
+ private:
+  Graph *_g;
+  int _size;
+  int _n;
+  int *_color;            // Color of each node
+  double *_count;         // c(v, C) for the C with the color of v
+  double *_sum;           // S(v, C) for the C without the color of v
+  double *_roots;         // Prefix sums of c(v, all colors)
+  vector<int> *_bySize;   // Color sets with each number of colors
+  map<string, double> _spanning; // Spanning trees of each class found
+
+  int  _index(int v, int set);
+  double &_c(int v, int set) {return _count[(long long)v<<(_size-1) | _index(v, set)];}
+  double &_s(int v, int set) {return _sum[(long long)v<<(_size-1) | _index(v, set)];}
+  void _countTrees();
+  void _sample(int v, int set, int *nodes, int *n);
+  double _spanningTrees(int *nodes);
+
+ public:
+  ColorCoding(Graph *g, int size); // Needs Isomorphism::initNauty
+  ~ColorCoding();
+
+  // Color the graph at random (seed 's') and take 'samples' colorful
+  // trees, adding the estimated frequency of each class found (canonical
+  // adjacency strings) to 'est'. Returns the number of colorful trees
+  double estimate(int s, int samples, map<string, double> *est);
+};
+
+#endif
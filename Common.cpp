@@ -0,0 +1,27 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Definitions of the "global" variables
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Common.h"
+
+// "Global" Variables (acessible on every src file)
+bool  Global::show_occ;
+FILE *Global::occ_file;
+OccIndex *Global::occ_index = NULL;
+int  *Global::labels = NULL;
+vector<string> *Global::names = NULL;
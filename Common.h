@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Common definitions
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ----------------------------------------------------
 */
 
@@ -62,9 +62,10 @@ Last Update: 11/02/2012
 #define DEFAULT_RESULTS "results"    // Default name for results file
 #define DEFAULT_OCC "occ"            // Default name for occurrences file
 
-typedef enum {NOMETHOD, ESU, GTRIE, SUBGRAPHS} MethodType;
+typedef enum {NOMETHOD, ESU, GTRIE, SUBGRAPHS, COMPLETE, HYBRID, COLORCODING, RANDOMWALK, TRIADS, GRAPHLETS} MethodType;
 typedef enum {NOOUTPUT, TEXT, HTML}            OutputType;
 typedef enum {NOFORMAT, SIMPLE, SIMPLE_WEIGHT} FormatType;
+typedef enum {NOORDER, NATURAL, DEGREE, DEGREE_DESC, DEGENERACY, BFS, RCM} OrderType;
 
 using namespace std; // Could be avoided if wanted
 
@@ -83,11 +84,25 @@ typedef struct {
 } ResultType;
 
 
+class OccIndex; // see OccIndex.h
+
 // Class for "global" variables
 class Global {
  public:
   static bool show_occ;  // Show occurrences?
   static FILE *occ_file; // FILE handle for dumping occurrences;
+  static OccIndex *occ_index; // Index of the occurrences (NULL: none)
+  static int *labels;    // Original label of each node (NULL if not renumbered)
+  static vector<string> *names; // Identifier of each label on the graph file (NULL: the label)
+
+  // Label of node 'v' on the original graph file
+  static int label(int v) {return labels==NULL ? v+1 : labels[v];}
+
+  // Write identifier of node 'v' on the graph file (after 'sep')
+  static void writeLabel(FILE *f, int v, const char *sep = " ") {
+    if (names==NULL) fprintf(f, "%s%d", sep, label(v));
+    else             fprintf(f, "%s%s", sep, (*names)[label(v)-1].c_str());
+  }
 };
 
 #endif
@@ -54,12 +54,7 @@ class LessConditions {
 };
 
 class Conditions {
- private:
-    static int _subgraph_size;
-
  public:
-    static void findAutomorphisms(Graph *g, VVsmallNode *vv);
-    static void isomorphicExtensions();
     static void symmetryConditions(Graph *g, list<iPair> *cond);
 };
 
@@ -0,0 +1,282 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Daemon mode: census requests served on a Unix socket
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Daemon.h"
+#include "Error.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <csignal>
+#include <cerrno>
+#include <climits>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+// Static variables
+map<int, int> Daemon::_workers;
+int Daemon::_wake[2] = {-1, -1};
+
+// Wakes the daemon (see serve), so that finished workers are collected
+// and their clients get the reply as soon as they end
+static void _childDone(int) {
+  int e = errno;
+  if (write(Daemon::wakeFd(), "", 1) < 0) {} // full: already woken
+  errno = e;
+}
+
+bool Daemon::_read(int fd, void *p, size_t n) {
+  char *c = (char *)p;
+  while (n>0) {
+    ssize_t r = read(fd, c, n);
+    if (r<0 && errno==EINTR) continue;
+    if (r<=0) return false;
+    c += r;
+    n -= r;
+  }
+  return true;
+}
+
+bool Daemon::_write(int fd, const void *p, size_t n) {
+  const char *c = (const char *)p;
+  while (n>0) {
+    ssize_t r = write(fd, c, n);
+    if (r<0 && errno==EINTR) continue;
+    if (r<=0) return false;
+    c += r;
+    n -= r;
+  }
+  return true;
+}
+
+bool Daemon::_writeString(int fd, const char *s) {
+  int len = strlen(s);
+  return _write(fd, &len, sizeof(int)) && _write(fd, s, len);
+}
+
+// Request as an argv (the working directory first), NULL if invalid
+char **Daemon::_readRequest(int fd, int *argc) {
+  int i, n, len;
+  char **argv;
+
+  if (!_read(fd, &n, sizeof(int)) || n<2 || n>DAEMON_MAX_ARGS) return NULL;
+  argv = new char*[n+1];
+  for (i=0; i<n; i++) {
+    if (!_read(fd, &len, sizeof(int)) || len<0 || len>=MAX_BUF) break;
+    argv[i] = new char[len+1];
+    if (!_read(fd, argv[i], len)) {delete[] argv[i]; break;}
+    argv[i][len] = 0;
+  }
+  if (i<n) {
+    _freeRequest(i, argv);
+    return NULL;
+  }
+  argv[n] = NULL;
+  *argc = n;
+  return argv;
+}
+
+void Daemon::_freeRequest(int argc, char **argv) {
+  for (int i=0; i<argc; i++) delete[] argv[i];
+  delete[] argv;
+}
+
+// Send the exit status of a request and close its connection
+void Daemon::_reply(int c, int status) {
+  _write(c, &status, sizeof(int));
+  close(c);
+}
+
+// Collect finished workers (waiting for one if 'block'), replying to their clients
+void Daemon::_reap(bool block) {
+  int status;
+  pid_t pid;
+  while (!_workers.empty() && (pid = waitpid(-1, &status, block ? 0 : WNOHANG))>0) {
+    map<int, int>::iterator w = _workers.find(pid);
+    if (w != _workers.end()) {
+      _reply(w->second, WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE);
+      _workers.erase(w);
+    }
+    block = false;
+  }
+}
+
+// Socket connected to (or listening on) 'path'
+int Daemon::_connect(const char *path, bool listen) {
+  struct sockaddr_un addr;
+  int fd;
+
+  if (strlen(path)>=sizeof(addr.sun_path))
+    Error::msg("Socket name \"%s\" is too long", path);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd<0) Error::msg(NULL);
+  if (listen) {
+    unlink(path); // left by a previous daemon
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr))!=0 || ::listen(fd, SOMAXCONN)!=0)
+      Error::msg("Unable to listen on socket \"%s\"", path);
+  } else if (connect(fd, (struct sockaddr *)&addr, sizeof(addr))!=0)
+    Error::msg("Unable to connect to daemon on socket \"%s\"", path);
+  return fd;
+}
+
+// Requests are prepared one at a time on the daemon process (so what they
+// load stays cached), and then run on a forked worker. nauty and most of the
+// program use static state, so workers are processes, not threads. Errors
+// while preparing are thrown (see Error::setThrow) and end just that request.
+// The connection is kept until the worker ends, to reply with its exit status
+void Daemon::serve(const char *path, int workers, DaemonPrepare prepare, DaemonRun run) {
+  int fd, c, argc, out, err;
+  char **argv;
+  bool ok;
+  pid_t pid = 0;
+  struct sigaction sa;
+
+  signal(SIGPIPE, SIG_IGN); // clients may leave early
+  memset(&sa, 0, sizeof(sa));
+  if (pipe(_wake)!=0) Error::msg(NULL);
+  fcntl(_wake[0], F_SETFL, O_NONBLOCK);
+  fcntl(_wake[1], F_SETFL, O_NONBLOCK);
+  sa.sa_handler = _childDone; // no SA_RESTART
+  sigaction(SIGCHLD, &sa, NULL);
+  fd = _connect(path, true);
+  printf("Daemon listening on \"%s\" (%d workers)\n", path, workers);
+  fflush(stdout);
+
+  while (true) {
+    _reap(false);
+    while ((int)_workers.size()>=workers) _reap(true);
+
+    struct pollfd p[2] = {{fd, POLLIN, 0}, {_wake[0], POLLIN, 0}};
+    if (poll(p, 2, -1)<0) {
+      if (errno==EINTR) continue;
+      Error::msg(NULL);
+    }
+    if (p[1].revents) {
+      char b[64];
+      while (read(_wake[0], b, sizeof(b))>0) ;
+    }
+    if (!(p[0].revents & POLLIN)) continue;
+
+    c = accept(fd, NULL, NULL);
+    if (c<0) {
+      if (errno==EINTR || errno==ECONNABORTED) continue;
+      Error::msg(NULL);
+    }
+    argv = _readRequest(c, &argc);
+    if (argv==NULL) {close(c); continue;}
+
+    // Output of the request goes to the client
+    fflush(stdout);
+    fflush(stderr);
+    out = dup(1);
+    err = dup(2);
+    dup2(c, 1);
+    dup2(c, 2);
+
+    ok = false;
+    Error::setThrow(true);
+    try {
+      if (chdir(argv[0])!=0) Error::msg("Invalid working directory \"%s\"", argv[0]);
+      ok = prepare(argc-1, argv+1);
+    } catch (ErrorException &e) {
+      fflush(stdout);
+      fprintf(stderr, "%s%s\n", ERROR_HEADER, e.what());
+    }
+    Error::setThrow(false);
+    fflush(stdout);
+    fflush(stderr);
+
+    if (ok) {
+      pid = fork();
+      if (pid==0) {
+	signal(SIGCHLD, SIG_DFL);
+	close(_wake[0]);
+	close(_wake[1]);
+	for (map<int, int>::iterator w=_workers.begin(); w!=_workers.end(); w++)
+	  close(w->second); // clients of the other workers
+	close(fd);
+	close(out);
+	close(err);
+	close(c);
+	run();
+	exit(0);
+      }
+      if (pid<0) Error::msg(NULL);
+    }
+
+    dup2(out, 1);
+    dup2(err, 2);
+    close(out);
+    close(err);
+    if (ok) _workers[pid] = c;
+    else    _reply(c, EXIT_FAILURE);
+    _freeRequest(argc, argv);
+  }
+}
+
+int Daemon::client(const char *path, int argc, char **argv) {
+  char cwd[PATH_MAX], buf[BUFSIZ+sizeof(int)];
+  int i, n, fd, status;
+  size_t have = 0;
+  ssize_t r;
+
+  if (getcwd(cwd, PATH_MAX)==NULL) Error::msg(NULL);
+  fd = _connect(path, false);
+
+  n = argc+1;
+  bool ok = _write(fd, &n, sizeof(int)) && _writeString(fd, cwd);
+  for (i=0; ok && i<argc; i++)
+    ok = _writeString(fd, argv[i]);
+  if (!ok) Error::msg("Unable to send request to daemon on socket \"%s\"", path);
+  shutdown(fd, SHUT_WR);
+
+  // The last int is the status, so it is held back until the end
+  while ((r = read(fd, buf+have, BUFSIZ))>0 || (r<0 && errno==EINTR)) {
+    if (r<=0) continue;
+    have += r;
+    if (have > sizeof(int)) {
+      fwrite(buf, 1, have-sizeof(int), stdout);
+      memmove(buf, buf+have-sizeof(int), sizeof(int));
+      have = sizeof(int);
+    }
+  }
+  close(fd);
+  if (have < sizeof(int)) {
+    fflush(stdout);
+    fprintf(stderr, "%sConnection to daemon on socket \"%s\" lost\n", ERROR_HEADER, path);
+    return EXIT_FAILURE;
+  }
+  memcpy(&status, buf, sizeof(int));
+  return status;
+}
+
+bool Daemon::fileKey(const char *file, string *name, long long *mtime) {
+  char full[PATH_MAX];
+  struct stat st;
+
+  if (realpath(file, full)==NULL || stat(full, &st)!=0) return false;
+  *name  = full;
+  *mtime = st.st_mtim.tv_sec*1000000000LL + st.st_mtim.tv_nsec;
+  return true;
+}
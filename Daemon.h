@@ -0,0 +1,69 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Daemon mode: census requests served on a Unix socket
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _DAEMON_
+#define _DAEMON_
+
+#include "Common.h"
+
+#define DAEMON_DEFAULT_WORKERS 4    // Requests run at the same time
+#define DAEMON_MAX_ARGS        1024 // Arguments of a request
+
+// Prepare request 'argv' on the daemon process (e.g. load what should
+// stay cached). Output already goes to the client. Returns whether the
+// request should be run (false: it failed). Errors are thrown, see Error
+typedef bool (*DaemonPrepare)(int argc, char **argv);
+
+// Run the prepared request on a worker process (forked from the daemon,
+// so it sees everything the daemon has loaded)
+typedef void (*DaemonRun)();
+
+// A request is the working directory of the client followed by its
+// arguments (argv[0] included), each sent as its length and its chars.
+// The reply is the output of the request followed by its exit status
+// (an int, 0 if it succeeded), and then the connection closes
+class Daemon {
+ private:
+  static map<int, int> _workers; // Connection of each running worker (by pid)
+  static int _wake[2];           // Pipe written when a worker ends
+
+  static bool _read(int fd, void *p, size_t n);
+  static bool _write(int fd, const void *p, size_t n);
+  static bool _writeString(int fd, const char *s);
+  static char **_readRequest(int fd, int *argc);
+  static void _freeRequest(int argc, char **argv);
+  static void _reap(bool block);
+  static void _reply(int c, int status);
+  static int  _connect(const char *path, bool listen);
+
+ public:
+  // Serve requests on socket 'path' (never returns), running at most 'workers' at a time
+  static void serve(const char *path, int workers, DaemonPrepare prepare, DaemonRun run);
+
+  // Send request 'argv' to the daemon on 'path' and copy its output to stdout.
+  // Returns the exit status of the request
+  static int client(const char *path, int argc, char **argv);
+
+  static int wakeFd() {return _wake[1];}
+
+  // Absolute name and modification time (ns) of 'file' (false if it does not exist)
+  static bool fileKey(const char *file, string *name, long long *mtime);
+};
+
+#endif
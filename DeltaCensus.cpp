@@ -0,0 +1,230 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Incremental census under edge changes
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "DeltaCensus.h"
+#include "Isomorphism.h"
+
+DeltaCensus::DeltaCensus(Graph *g, int size, bool dir, mapStringInt *count) {
+  int clab[size], orb[size];
+  char canon[size*size+1];
+  mapStringInt::iterator ii;
+
+  _g     = g;
+  _size  = size;
+  _dir   = dir;
+  _count = count;
+
+  _near = new int[g->numNodes()];
+  memset(_near, 0, g->numNodes()*sizeof(int));
+  _set = new int[size];
+  _ext = new vector<int>[size+1];
+  _nextra = 0;
+
+  // Subgraphs already there keep their keys
+  for (ii=count->begin(); ii!=count->end(); ii++) {
+    Isomorphism::canonicalLabelling(ii->first.c_str(), size, dir, clab, orb, canon);
+    _classes[canon] = &ii->second;
+  }
+}
+
+DeltaCensus::~DeltaCensus() {
+  delete[] _near;
+  delete[] _set;
+  delete[] _ext;
+}
+
+// Frequency of the subgraph with adjacency matrix 'adj'
+int *DeltaCensus::_frequency(const char *adj) {
+  int clab[_size], orb[_size];
+  char canon[_size*_size+1], key[_size*_size+1];
+  map<string, int *>::iterator ii;
+
+  Isomorphism::canonicalLabelling(adj, _size, _dir, clab, orb, canon);
+  ii = _classes.find(canon);
+  if (ii != _classes.end()) return ii->second;
+
+  // New subgraph (same key as a census would give)
+  Isomorphism::canonicalBasedNauty(canon, key, _size);
+  int *f = &(*_count)[key];
+  _classes[canon] = f;
+  return f;
+}
+
+// Is the subgraph with adjacency 'mask' connected?
+bool DeltaCensus::_connected(unsigned long long mask) {
+  int i, j, nbfs, bfs[_size];
+  bool seen[_size];
+
+  for (i=0; i<_size; i++) seen[i] = false;
+  seen[0] = true; bfs[0] = 0; nbfs = 1;
+  for (i=0; i<nbfs; i++)
+    for (j=0; j<_size; j++)
+      if (!seen[j] && ((mask>>(bfs[i]*_size+j)) & 1 || (mask>>(j*_size+bfs[i])) & 1)) {
+	seen[j] = true;
+	bfs[nbfs++] = j;
+      }
+  return nbfs == _size;
+}
+
+// Frequencies changed by the subgraph with adjacency 'mask'
+// (its first two nodes are the endpoints of the edge)
+DeltaPattern *DeltaCensus::_pattern(unsigned long long mask) {
+  int i;
+  char adj[_size*_size+1];
+  unsigned long long without;
+  unordered_map<unsigned long long, DeltaPattern>::iterator ii;
+
+  ii = _patterns.find(mask);
+  if (ii != _patterns.end()) return &ii->second;
+
+  DeltaPattern p;
+  for (i=0; i<_size*_size; i++) adj[i] = (mask>>i) & 1 ? '1' : '0';
+  adj[_size*_size] = 0;
+  p.with = _frequency(adj);
+
+  without = mask & ~(1ULL<<1);
+  if (!_dir) without &= ~(1ULL<<_size);
+  if (_connected(without)) {
+    for (i=0; i<_size*_size; i++) adj[i] = (without>>i) & 1 ? '1' : '0';
+    p.without = _frequency(adj);
+  } else
+    p.without = NULL;
+
+  return &(_patterns[mask] = p);
+}
+
+// Add 'inc' to the neighbours of 'w' (the ones which were on no
+// subgraph node or neighbour are added to 'ext', when given)
+void DeltaCensus::_mark(int w, int inc, vector<int> *ext) {
+  int i, u, n;
+  bool **adjM = _g->adjacencyMatrix();
+  vector<int> *v = _g->neighbours(w);
+
+  n = v->size();
+  for (i=0; i<n+2*_nextra; i++) {
+    if (i<n) u = (*v)[i];
+    else if (w == _extra[i-n]) u = _extra[(i-n)^1];
+    else continue;
+    if (!adjM[w][u] && !adjM[u][w]) continue;
+    if (ext!=NULL && _near[u]==0) ext->push_back(u);
+    _near[u] += inc;
+  }
+}
+
+// Adjacency of the subgraph with 'w' as node 'depth'
+// (adds its edges to the adjacency 'mask' of the nodes before)
+unsigned long long DeltaCensus::_adjacency(unsigned long long mask, int depth, int w) {
+  int i;
+  bool **adjM = _g->adjacencyMatrix();
+
+  for (i=0; i<depth; i++) {
+    if (adjM[_set[i]][w]) mask |= 1ULL<<(i*_size+depth);
+    if (adjM[w][_set[i]]) mask |= 1ULL<<(depth*_size+i);
+  }
+  return mask;
+}
+
+// Grow subgraph (with adjacency 'mask') with nodes of 'ext' (ESU)
+void DeltaCensus::_go(int depth, unsigned long long mask, vector<int> &ext) {
+  int i, n = ext.size();
+
+  if (depth == _size-1) {
+    for (i=0; i<n; i++) {
+      DeltaPattern *p = _pattern(_adjacency(mask, depth, ext[i]));
+      *p->with += _sign;
+      if (p->without != NULL) *p->without -= _sign;
+    }
+    return;
+  }
+
+  vector<int> &next = _ext[depth+1];
+  for (i=0; i<n; i++) {
+    next.assign(ext.begin()+i+1, ext.end());
+    _mark(ext[i], 1, &next);
+    _set[depth] = ext[i];
+    _go(depth+1, _adjacency(mask, depth, ext[i]), next);
+    _mark(ext[i], -1, NULL);
+  }
+}
+
+// Update frequencies for edge a-b (which must be on the graph),
+// as if it was just added (sign=1) or is about to be removed (sign=-1):
+// every subgraph with it changes to the one without it (if still connected)
+void DeltaCensus::_delta(int a, int b, int sign) {
+  _sign = sign;
+  _set[0] = a;
+  _set[1] = b;
+  _near[a]++;
+  _near[b]++;
+  _ext[2].clear();
+  _mark(a, 1, &_ext[2]);
+  _mark(b, 1, &_ext[2]);
+  _go(2, _adjacency(0, 1, b), _ext[2]);
+  _mark(a, -1, NULL);
+  _mark(b, -1, NULL);
+  _near[a]--;
+  _near[b]--;
+}
+
+void DeltaCensus::_toggle(int a, int b, bool on) {
+  bool **adjM = _g->adjacencyMatrix();
+  adjM[a][b] = on;
+  if (!_dir) adjM[b][a] = on;
+}
+
+void DeltaCensus::addEdge(int a, int b) {
+  if (a==b || _g->hasEdge(a,b)) return;
+  _g->addEdge(a,b);
+  if (!_dir) _g->addEdge(b,a);
+  _delta(a, b, 1);
+}
+
+void DeltaCensus::rmEdge(int a, int b) {
+  if (!_g->hasEdge(a,b)) return;
+  _delta(a, b, -1);
+  _g->rmEdge(a,b);
+  if (!_dir) _g->rmEdge(b,a);
+}
+
+// The graph goes back through the steps of the swap (only on the adjacency
+// matrix, the removed edges are added to the neighbours while doing it)
+void DeltaCensus::swap(int a, int b, int c, int d) {
+  _extra[0] = a; _extra[1] = b;
+  _extra[2] = c; _extra[3] = d;
+  _nextra = 2;
+
+  _delta(c, b, 1);
+  _toggle(c, b, false);
+  _delta(a, d, 1);
+  _toggle(a, d, false);
+  _toggle(c, d, true);
+  _delta(c, d, -1);
+  _toggle(a, b, true);
+  _delta(a, b, -1);
+
+  _toggle(a, b, false);
+  _toggle(c, d, false);
+  _toggle(a, d, true);
+  _toggle(c, b, true);
+  _nextra = 0;
+}
+
+void DeltaCensus::swapHook(int a, int b, int c, int d, void *dc) {
+  ((DeltaCensus *)dc)->swap(a, b, c, d);
+}
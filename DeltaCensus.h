@@ -0,0 +1,83 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Incremental census under edge changes
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _DELTACENSUS_
+#define _DELTACENSUS_
+
+#include "Common.h"
+#include "Graph.h"
+#include <unordered_map>
+
+#define DELTA_MAX_SIZE 8 // Adjacency of a subgraph must fit on 64 bits
+
+// What changes when an edge of a pattern goes away
+typedef struct {
+  int *with;     // Frequency of the pattern
+  int *without;  // Frequency of the pattern without the edge (NULL: disconnected)
+} DeltaPattern;
+
+// Keeps the frequencies of all k-subgraphs of a graph up to date as edges
+// are added and removed, by only visiting the k-subgraphs with that edge
+// (found by ESU seeded with both endpoints). Each of them is identified by
+// its adjacency (in the order it was found), and every adjacency is only
+// given to nauty the first time it shows up.
+// Frequencies are kept on a map given by the caller, whose keys are used
+// for the subgraphs it already has (subgraphs not there are added).
+// Needs the graph neighbours as vectors and Isomorphism::initNauty.
+class DeltaCensus {
+ private:
+  Graph *_g;
+  int _size;
+  bool _dir;
+  mapStringInt *_count;
+
+  unordered_map<unsigned long long, DeltaPattern> _patterns;
+  map<string, int *> _classes; // Frequency of each nauty canonical form
+
+  int *_near;                  // Number of subgraph nodes each node is (or is next to)
+  int *_set;                   // Current subgraph
+  vector<int> *_ext;           // Extension of each depth
+  int _sign;                   // +1: edge was added, -1: edge will be removed
+  int _extra[4];               // Edges not on the neighbour lists (during a swap)
+  int _nextra;
+
+  int *_frequency(const char *adj);
+  DeltaPattern *_pattern(unsigned long long mask);
+  bool _connected(unsigned long long mask);
+  void _mark(int w, int inc, vector<int> *ext);
+  unsigned long long _adjacency(unsigned long long mask, int depth, int w);
+  void _go(int depth, unsigned long long mask, vector<int> &ext);
+  void _delta(int a, int b, int sign);
+  void _toggle(int a, int b, bool on);
+
+ public:
+  // 'count' must have the frequencies of 'g'
+  DeltaCensus(Graph *g, int size, bool dir, mapStringInt *count);
+  ~DeltaCensus();
+
+  void addEdge(int a, int b); // Add edge to the graph and update frequencies
+  void rmEdge(int a, int b);  // Remove edge from the graph and update frequencies
+
+  // Update frequencies after edges a-b and c-d were swapped to a-d and c-b
+  // (the graph already has the swap)
+  void swap(int a, int b, int c, int d);
+  static void swapHook(int a, int b, int c, int d, void *dc); // see Random::SwapHook
+};
+
+#endif
@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Error Utilities
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #include "Error.h"
@@ -24,17 +24,20 @@ Last Update: 11/02/2012
 #include <errno.h>
 #include <string.h>
 
+thread_local bool Error::_throw = false;
+
 void Error::msg(const char *format, ...) {
   va_list p;
+  char s[2*MAX_BUF];
+
   if (format == NULL)
     msg("%s", (char *)strerror (errno));
-  else {
-      fprintf (stderr, ERROR_HEADER);
-      va_start (p, format);
-      vfprintf (stderr, format, p);
-      va_end (p);
-      fprintf (stderr, "\n");
-    }
+  va_start (p, format);
+  vsnprintf (s, sizeof(s), format, p);
+  va_end (p);
+  if (_throw) throw ErrorException(s);
 
+  fflush(stdout); // keep the order of the output when both go to the same place
+  fprintf (stderr, "%s%s\n", ERROR_HEADER, s);
   exit(EXIT_FAILURE);
 }
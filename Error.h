@@ -14,19 +14,34 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Error Utilities
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #ifndef _ERROR_
 #define _ERROR_
 
 #include "Graph.h"
+#include <stdexcept>
 
 #define EXIT_FAILURE 1
 
+// Thrown by Error::msg while errors are recoverable (see Error::setThrow)
+class ErrorException : public runtime_error {
+ public:
+  ErrorException(const char *s) : runtime_error(s) {}
+};
+
 class Error {
+ private:
+  static thread_local bool _throw;
+
  public:
   static void msg(const char *format, ...);
+
+  // While set (on the calling thread), errors throw an ErrorException
+  // with their message (not shown) instead of showing it and exiting
+  static void setThrow(bool t) {_throw = t;}
+  static bool throwing() {return _throw;}
 };
 
 #endif
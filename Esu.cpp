@@ -14,32 +14,83 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Esu implementation
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #include "Esu.h"
+#include "OccIndex.h"
 #include "Isomorphism.h"
 #include "Random.h"
+#include "Partition.h"
 
 // Class static variables
 int     Esu::_motif_size = 0;
 int     Esu::_graph_size = 0;
-int     Esu::_next = 0;
 int    *Esu::_current = NULL;
 int    *Esu::_ext = NULL;
+int    *Esu::_blocked = NULL;
+int     Esu::_top = 0;
+int   **Esu::_seg = NULL;
+int    *Esu::_nseg = NULL;
 Graph  *Esu::_g = NULL;
 double *Esu::_prob;
+const int *Esu::_seedDist = NULL;
+int    *Esu::_near = NULL;
 GraphTree *Esu::_sg;
 
 
-/*! Recursively extend a partial subgraph
+/*! Mark the neighbours of 'n' bigger than the root that are not yet
+    blocked (its exclusive neighbourhood) and push them on the extension stack
+    \param n the node just added to the subgraph
+    \param size the subgraph size (including 'n'), used as the mark */
+void Esu::_push(int n, int size) {
+  int *v  = _g->arrayNeighbours(n);
+  int num = _g->numNeighbours(n);
+  int i   = upper_bound(v, v+num, _current[0]) - v;
+
+  for (; i<num; i++)
+    if (!_blocked[v[i]]) {
+      _blocked[v[i]] = size;
+      _ext[_top++] = v[i];
+    }
+}
+
+/*! Unmark the nodes marked by _push(n, size) */
+void Esu::_pop(int n, int size) {
+  int *v  = _g->arrayNeighbours(n);
+  int num = _g->numNeighbours(n);
+
+  for (int i=0; i<num; i++)
+    if (_blocked[v[i]] == size) _blocked[v[i]] = 0;
+}
+
+/*! Extension of the child that uses position 'i' of segment 's' of
+    level 'size': all segments below it, and the start of segment 's' */
+void Esu::_inherit(int size, int s, int i) {
+  int *seg = _seg[size], *cseg = _seg[size+1];
+  int j;
+
+  for (j=0; j<2*s; j++) cseg[j] = seg[j];
+  if (i > seg[2*s]) {
+    cseg[j++] = seg[2*s];
+    cseg[j++] = i;
+  }
+  _nseg[size+1] = j/2;
+}
+
+/*! Recursively extend a partial subgraph. The extension is given by the
+    segments of the extension stack on _seg[size+1]
     \param n the current position in the constructed subgraph 
-    \param size the subgraph size
-    \param next number of elements in the list "ext"
-    \param ext of the nodes that can be used to extend the subgraph */
-void Esu::_go(int n, int size, int next, int *ext) {
+    \param size the subgraph size */
+void Esu::_go(int n, int size) {
   _current[size++] = n;
 
+  // A seed must be close enough to be reached with the nodes left
+  if (_seedDist != NULL) {
+    _near[size-1] = size==1 ? _seedDist[n] : min(_near[size-2], _seedDist[n]);
+    if (_near[size-1] > _motif_size-size) return;
+  }
+
   if (size==_motif_size) {
     char s[_motif_size*_motif_size+1];
     Isomorphism::canonicalStrNauty(_g, _current, s);
@@ -48,42 +99,43 @@ void Esu::_go(int n, int size, int next, int *ext) {
     if (Global::show_occ) {
       fprintf(Global::occ_file, "%s:", s);
       for (int i=0; i<size; i++)
-	fprintf(Global::occ_file, " %d", _current[i]+1);
+	Global::writeLabel(Global::occ_file, _current[i]);
       fputc('\n', Global::occ_file);
     }
+    if (Global::occ_index != NULL) {
+      int lab[_motif_size];
+      for (int i=0; i<size; i++) lab[i] = Global::label(_current[i])-1;
+      Global::occ_index->add(s, lab);
+    }
 
   } else {
-    int i,j;
-    int next2 = next;
-    int ext2[_graph_size];
-
-    for (i=0;i<next;i++) ext2[i] = ext[i];
-
-    int *v  = _g->arrayNeighbours(_current[size-1]);
-    int num = _g->numNeighbours(_current[size-1]);
+    int i, j;
+    int top = _top;
+    int *seg = _seg[size];
 
-
-    for (i=0;i<num;i++) {
-      if (v[i]<=_current[0]) continue;
-      for (j=0;j+1<size;j++)
-	if (_g->isConnected(v[i],_current[j])) break;
-      if (j+1==size) ext2[next2++]=v[i];      
+    _push(n, size);
+    if (_top > top) {
+      seg[2*_nseg[size]]   = top;
+      seg[2*_nseg[size]+1] = _top;
+      _nseg[size]++;
     }
 
-    while (next2>0) {      
-      next2--;
-      _go(ext2[next2], size, next2, ext2);
-    }
+    for (j=_nseg[size]-1; j>=0; j--)
+      for (i=seg[2*j+1]-1; i>=seg[2*j]; i--) {
+	_inherit(size, j, i);
+	_go(_ext[i], size);
+      }
+
+    _top = top;
+    _pop(n, size);
   }
   
 }
 
 /*! Recursively extend a partial subgraph (sampling version)
     \param n the current position in the constructed subgraph 
-    \param size the subgraph size
-    \param next number of elements in the list "ext"
-    \param ext of the nodes that can be used to extend the subgraph */
-void Esu::_goSample(int n, int size, int next, int *ext) {
+    \param size the subgraph size */
+void Esu::_goSample(int n, int size) {
 
   _current[size++] = n;
 
@@ -92,51 +144,91 @@ void Esu::_goSample(int n, int size, int next, int *ext) {
     Isomorphism::canonicalStrNauty(_g, _current, s);
     _sg->incrementString(s);
   } else {
-    int i,j;
-    int next2 = next;
-    int ext2[_graph_size];
-
-    for (i=0;i<next;i++) ext2[i] = ext[i];
-
-    int *v  = _g->arrayNeighbours(_current[size-1]);
-    int num = _g->numNeighbours(_current[size-1]);
-    for (i=0;i<num;i++) {
-      if (v[i]<=_current[0]) continue;
-      for (j=0;j+1<size;j++)
-	if (_g->isConnected(v[i],_current[j])) break;
-      if (j+1==size) ext2[next2++]=v[i];      
-    }
-    while (next2>0) {
-      next2--;
-      if (Random::getDouble()<=_prob[size])
-	_goSample(ext2[next2], size, next2, ext2);
+    int i, j;
+    int top = _top;
+    int *seg = _seg[size];
+
+    _push(n, size);
+    if (_top > top) {
+      seg[2*_nseg[size]]   = top;
+      seg[2*_nseg[size]+1] = _top;
+      _nseg[size]++;
     }
+
+    for (j=_nseg[size]-1; j>=0; j--)
+      for (i=seg[2*j+1]-1; i>=seg[2*j]; i--)
+	if (Random::getDouble()<=_prob[size]) {
+	  _inherit(size, j, i);
+	  _goSample(_ext[i], size);
+	}
+
+    _top = top;
+    _pop(n, size);
   }
   
 }
 
-/*! Make a complete k-census of a Graph
-    \param g the graph to be explored
-    \param k the size of the subgraphs
-    \param sg The GraphTree where the results should be stored */
-void Esu::countSubgraphs(Graph *g, int k, GraphTree *sg) {
-  int i, v[1];
+/*! Allocate the search state for k-subgraphs of 'g' (results on 'sg') */
+void Esu::_init(Graph *g, int k, GraphTree *sg) {
+  int i;
 
   _motif_size = k;
   _graph_size = g->numNodes();
   _current = new int[k];
   _ext = new int[_graph_size];
-  _next = 0;
+  _blocked = new int[_graph_size];
+  _seg = new int*[k+1];
+  for (i=0; i<=k; i++)
+    _seg[i] = new int[2*k];
+  _nseg = new int[k+1];
+  _near = new int[k];
+  _top = 0;
   _g = g;
   _sg = sg;
 
   sg->zeroFrequency();
+  for (i=0; i<_graph_size; i++)
+    _blocked[i] = 0;
+}
 
-   for (i=0; i<_graph_size; i++)
-    _go(i, 0, 0, v);
-  
+/*! Free the search state */
+void Esu::_finish() {
   delete[] _current;
   delete[] _ext;
+  delete[] _blocked;
+  for (int i=0; i<=_motif_size; i++)
+    delete[] _seg[i];
+  delete[] _seg;
+  delete[] _nseg;
+  delete[] _near;
+}
+
+/*! Make a complete k-census of a Graph
+    \param g the graph to be explored
+    \param k the size of the subgraphs
+    \param sg The GraphTree where the results should be stored */
+void Esu::countSubgraphs(Graph *g, int k, GraphTree *sg) {
+  countSubgraphs(g, k, sg, NULL);
+}
+
+/*! Make a k-census of the subgraphs with at least one seed. Only the
+    subgraphs that can still reach a seed are extended, so the search
+    stays on the neighbourhood of the seeds
+    \param g the graph to be explored
+    \param k the size of the subgraphs
+    \param sg The GraphTree where the results should be stored
+    \param seedDist distance of each node to the nearest seed
+    (see GraphUtils::seedDistances, NULL: count all subgraphs) */
+void Esu::countSubgraphs(Graph *g, int k, GraphTree *sg, const int *seedDist) {
+  _init(g, k, sg);
+  _seedDist = seedDist;
+  for (int i=0; i<_graph_size; i++)
+    if (Partition::owns(i)) {
+      _nseg[1] = 0;
+      _go(i, 0);
+    }
+  _seedDist = NULL;
+  _finish();
 }
 
 /*! Make a complete k-census of a Graph (sampling version)
@@ -145,23 +237,41 @@ void Esu::countSubgraphs(Graph *g, int k, GraphTree *sg) {
     \param sg The GraphTree where the results should be stored
     \param p array of probabilities to use in sampling*/
 void Esu::countSubgraphsSample(Graph *g, int k, GraphTree *sg, double *p) {
-  int i, v[1];
-
-  _motif_size = k;
-  _graph_size = g->numNodes();
-  _current = new int[k];
-  _ext = new int[_graph_size];
-  _next = 0;
-  _g = g;
-  _sg = sg;
+  _init(g, k, sg);
   _prob = p;
+  for (int i=0; i<_graph_size; i++)
+    if (Random::getDouble()<=_prob[0]) {
+      _nseg[1] = 0;
+      _goSample(i, 0);
+    }
+  _finish();
+}
 
-  sg->zeroFrequency();
+/*! Sampling census of the subgraphs rooted at nodes [first, last).
+    The generator is seeded with 'seed'+root before each root, so the
+    sample does not depend on how the roots are split among processes
+    (its previous state is restored at the end)
+    \param g the graph to be explored
+    \param k the size of the subgraphs
+    \param sg The GraphTree where the results should be stored
+    \param p array of probabilities to use in sampling
+    \param first first root
+    \param last root after the last one
+    \param seed base seed */
+void Esu::countSubgraphsSample(Graph *g, int k, GraphTree *sg, double *p,
+			       int first, int last, int seed) {
+  char state[RANDOM_STATE_SIZE];
 
-  for (i=0; i<_graph_size; i++)
-    if (Random::getDouble()<=_prob[0])
-      _goSample(i, 0, 0, v);
-  
-  delete[] _current;
-  delete[] _ext;
+  Random::getState(state);
+  _init(g, k, sg);
+  _prob = p;
+  for (int i=first; i<last; i++) {
+    Random::seed(seed+i);
+    if (Random::getDouble()<=_prob[0]) {
+      _nseg[1] = 0;
+      _goSample(i, 0);
+    }
+  }
+  _finish();
+  Random::setState(state);
 }
@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Esu implementation
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #ifndef _ESU_
@@ -27,20 +27,33 @@ Last Update: 11/02/2012
 class Esu {
  private:
   static int *_current;
-  static int * _ext;
-  static int _next;
+  static int * _ext;     // Extension stack (each node at most once)
+  static int _top;       // Top of the extension stack
+  static int **_seg;     // Extension of each level: segments [start,end) of the stack
+  static int * _nseg;    // Number of segments of each level
+  static int * _blocked; // Subgraph size at which each node was reached (0 = free)
   static int _graph_size;
   static int _motif_size;
   static Graph * _g;
   static GraphTree *_sg;
   static double *_prob;
+  static const int *_seedDist; // Distance of each node to the seeds (NULL: no seeds)
+  static int *_near;           // Smallest seed distance of the subgraph up to each size
 
-  static void _go(int n, int size, int next, int *ext);
-  static void _goSample(int n, int size, int next, int *ext);
+  static void _push(int n, int size);
+  static void _pop(int n, int size);
+  static void _inherit(int size, int s, int i);
+  static void _go(int n, int size);
+  static void _goSample(int n, int size);
+  static void _init(Graph *g, int k, GraphTree *sg);
+  static void _finish();
 
  public:
   static void countSubgraphs(Graph *g, int k, GraphTree *sg);
+  static void countSubgraphs(Graph *g, int k, GraphTree *sg, const int *seedDist);
   static void countSubgraphsSample(Graph *g, int k, GraphTree *sg, double *p);
+  static void countSubgraphsSample(Graph *g, int k, GraphTree *sg, double *p,
+				   int first, int last, int seed);
   
 };
 
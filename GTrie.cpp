@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 G-Trie Implementation and associated methods
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #include "GTrie.h"
@@ -25,25 +25,45 @@ Last Update: 11/02/2012
 #include "Conditions.h"
 #include "Random.h"
 #include "Error.h"
+#include "SetOps.h"
+#include "Parallel.h"
+#include "OccIndex.h"
 #include <iostream>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <assert.h>
 
-int *GTrieNode::mymap;
-bool *GTrieNode::used;
-bool **GTrieNode::adjM;
-int **GTrieNode::fastnei;
-int *GTrieNode::numnei;
-int GTrieNode::glk;
-int GTrieNode::numNodes;
-bool GTrieNode::isdir;
-double *GTrieNode::prob;
+CondList::const_iterator jj, jjend;
+PairList::const_iterator kk, kkend;
 
-list< list<iPair> >::const_iterator jj, jjend;
-list<iPair>::const_iterator kk, kkend;
 
-GTrieNode::GTrieNode(int d) {
+// Read a whole line of 'f' on 'l' (NULL at end of file)
+static char *_readLine(FILE *f, LineBuffer *l) {
+  int len = 0;
+
+  if (l->buf == NULL) {
+    l->size = MAX_BUF;
+    l->buf  = (char *)malloc(l->size);
+  }
+  while (fgets(l->buf+len, l->size-len, f)) {
+    len += strlen(l->buf+len);
+    if (l->buf[len-1] == '\n') return l->buf;
+    l->size *= 2;
+    l->buf = (char *)realloc(l->buf, l->size);
+    if (l->buf == NULL) Error::msg("Out of memory (g-trie line)");
+  }
+  return len>0 ? l->buf : NULL;
+}
+
+GTrieNode::GTrieNode(int d, Arena *a)
+  : _arena(a), _index(NULL),
+    this_node_cond(ArenaAllocator<IntList>(a)),
+    cond(ArenaAllocator<PairList>(a)),
+    child(ArenaAllocator<GTrieNode *>(a)) {
 
   depth     = d;
 
@@ -52,9 +72,9 @@ GTrieNode::GTrieNode(int d) {
   nconn=0;
 
   if (d!=0) {
-    in   = new bool[d];
-    out  = new bool[d];
-    conn = new int[d];
+    in   = (bool *)_arena->alloc(d*sizeof(bool));
+    out  = (bool *)_arena->alloc(d*sizeof(bool));
+    conn = (int *)_arena->alloc(d*sizeof(int));
   } else {
     in = out = NULL;
     conn = NULL;
@@ -62,23 +82,76 @@ GTrieNode::GTrieNode(int d) {
 
   total_in = total_out = total_edges = 0;
 
-  child.clear();
-  cond.clear();
-  this_node_cond.clear();
-
   cond_ok = false;
   cond_this_ok = false;
 }
 
-GTrieNode::~GTrieNode() {
-  if (depth!=0) {
-    if (in  != NULL) delete[] in;
-    if (out != NULL) delete[] out;
-    if (conn != NULL) delete[] conn;
+// Nodes are never deleted one by one: all memory goes away with the arena
+GTrieNode *GTrieNode::_newChild() {
+  return new (_arena->alloc(sizeof(GTrieNode))) GTrieNode(depth+1, _arena);
+}
+
+// Key of this node on the index of its parent
+PatternKey GTrieNode::_pattern() {
+  PatternKey k(0, 0);
+  for (int i=0; i<depth; i++) {
+    if (out[i]) k.first  |= 1ULL<<i;
+    if (in[i])  k.second |= 1ULL<<i;
   }
-  list<GTrieNode *>::iterator ii;
-  for(ii=child.begin(); ii!=child.end(); ii++)
-    delete *ii;
+  return k;
+}
+
+// Child matching the edges of node 'depth' of 'g' (NULL if none)
+GTrieNode *GTrieNode::_findChild(Graph *g) {
+  int i;
+
+  if (_index==NULL && (int)child.size() <= CHILD_LINEAR) {
+    ChildList::iterator ii;
+    for(ii=child.begin(); ii!=child.end(); ii++) {
+      for (i=0; i<=depth; i++)
+	if (g->hasEdge(depth, i) != (*ii)->out[i] ||
+	    g->hasEdge(i, depth) != (*ii)->in[i])
+	  break;
+      if (i>depth) return *ii;
+    }
+    return NULL;
+  }
+
+  if (_index==NULL) {
+    _index = new (_arena->alloc(sizeof(ChildIndex)))
+      ChildIndex(2*child.size(), PatternHash(), equal_to<PatternKey>(),
+		 ArenaAllocator<pair<const PatternKey, GTrieNode *> >(_arena));
+    ChildList::iterator ii;
+    for(ii=child.begin(); ii!=child.end(); ii++)
+      (*_index)[(*ii)->_pattern()] = *ii;
+  }
+
+  PatternKey k(0, 0);
+  for (i=0; i<=depth; i++) {
+    if (g->hasEdge(depth, i)) k.first  |= 1ULL<<i;
+    if (g->hasEdge(i, depth)) k.second |= 1ULL<<i;
+  }
+  ChildIndex::iterator ii = _index->find(k);
+  return ii==_index->end() ? NULL : ii->second;
+}
+
+// New child with the edges of node 'depth' of 'g'
+GTrieNode *GTrieNode::_addChild(Graph *g) {
+  int i;
+  GTrieNode *gt = _newChild();
+
+  for (i=0; i<=depth; i++) {
+    gt->out[i] = g->hasEdge(depth, i);
+    gt->in[i]  = g->hasEdge(i, depth);
+    if (g->isConnected(depth, i)) 
+      gt->conn[(gt->nconn)++] = i;
+
+    if (gt->in[i])  { (gt->total_in)++;  (gt->total_edges)++;}
+    if (gt->out[i]) { (gt->total_out)++; (gt->total_edges)++;}
+  }
+  child.push_back(gt);
+  if (_index!=NULL) (*_index)[gt->_pattern()] = gt;
+  return gt;
 }
 
 void GTrieNode::showAsText(FILE *f) {
@@ -94,8 +167,8 @@ void GTrieNode::showAsText(FILE *f) {
 
   if (cond_ok) fprintf(f,"{}");
   else {    
-    list< list<iPair> >:: iterator jj;
-    list<iPair>:: iterator kk;
+    CondList:: iterator jj;
+    PairList::iterator kk;
     for (jj=cond.begin(); jj!=cond.end(); jj++) {
       fputc('|', f);
       for (kk=(*jj).begin(); kk!=(*jj).end(); kk++) {
@@ -110,8 +183,8 @@ void GTrieNode::showAsText(FILE *f) {
 
   if (cond_this_ok) fprintf(f,"{}");
   else {
-    list< list<int> >:: iterator jjj;
-    list<int>:: iterator kkk;
+    IntListList:: iterator jjj;
+    IntList::iterator kkk;
     for (jjj=this_node_cond.begin(); jjj!=this_node_cond.end(); jjj++) {
       fputc('|', f);
       if ((*jjj).size()==0) fprintf(f,"{}");
@@ -130,7 +203,7 @@ void GTrieNode::showAsText(FILE *f) {
         
   fprintf(f,"%s\n", is_graph?"isGraph":"");
 
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     (*ii)->showAsText(f);
 }
@@ -138,7 +211,7 @@ void GTrieNode::showAsText(FILE *f) {
 int GTrieNode::frequencyGraph(Graph *g) {
   if (g->numNodes()==depth)
     return frequency;
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   int i;
   for(ii=child.begin(); ii!=child.end(); ii++) {
     for (i=0; i<=depth; i++)
@@ -154,68 +227,24 @@ int GTrieNode::frequencyGraph(Graph *g) {
 }
 
 void GTrieNode::insert(Graph *g) {
-  int i;
-
-
   if (g->numNodes() == depth) {
     is_graph = true;
   } else {
-    list<GTrieNode *>::iterator ii;
-    for(ii=child.begin(); ii!=child.end(); ii++) {
-      for (i=0; i<=depth; i++)
-	if (g->hasEdge(depth, i) != (*ii)->out[i] ||
-	    g->hasEdge(i, depth) != (*ii)->in[i])
-	  break;
-      if (i>depth) break;
-    }
-    if (ii==child.end()) {
-      GTrieNode *gt = new GTrieNode(depth+1);
-      for (i=0; i<=depth; i++) {
-      	gt->out[i] = g->hasEdge(depth, i);	
-      	gt->in[i]  = g->hasEdge(i, depth);
-	if (g->isConnected(depth, i)) 
-	  gt->conn[(gt->nconn)++] = i;
-
-	if (gt->in[i])  { (gt->total_in)++;  (gt->total_edges)++;}
-	if (gt->out[i]) { (gt->total_out)++; (gt->total_edges)++;}
-      }
-      gt->insert(g);
-      child.push_back(gt);
-    } else
-      (*ii)->insert(g);
+    GTrieNode *gt = _findChild(g);
+    if (gt==NULL) gt = _addChild(g);
+    gt->insert(g);
   }
 }
 
 
 void GTrieNode::insertCond(Graph *g, list<iPair> *cond) {
-  int i;
   GTrieNode *gt;
 
   if (g->numNodes() == depth) {
     is_graph = true;
   } else {
-    list<GTrieNode *>::iterator ii;
-    for(ii=child.begin(); ii!=child.end(); ii++) {
-      for (i=0; i<=depth; i++)
-	if (g->hasEdge(depth, i) != (*ii)->out[i] ||
-	    g->hasEdge(i, depth) != (*ii)->in[i])
-	  break;
-      if (i>depth) break;
-    }
-    if (ii==child.end()) {
-      gt = new GTrieNode(depth+1);
-      for (i=0; i<=depth; i++) {
-      	gt->out[i] = g->hasEdge(depth, i);	
-      	gt->in[i]  = g->hasEdge(i, depth);
-	if (g->isConnected(depth, i)) 
-	  gt->conn[(gt->nconn)++] = i;
-	if (gt->in[i])  { (gt->total_in)++;  (gt->total_edges)++;}
-	if (gt->out[i]) { (gt->total_out)++; (gt->total_edges)++;}
-      }
-      child.push_back(gt);
-    } else {
-      gt = (*ii);
-    }
+    gt = _findChild(g);
+    if (gt==NULL) gt = _addChild(g);
 
     gt->insertConditionsFiltered(cond);
     gt->insertCond(g, cond);
@@ -224,8 +253,8 @@ void GTrieNode::insertCond(Graph *g, list<iPair> *cond) {
 }
 
 // Assume a and b are in ascending order
-bool GTrieNode::_is_intset_included(list<int> a, list<int> b) {
-  list<int>::iterator aa, bb;
+bool GTrieNode::_is_intset_included(const IntList &a, const IntList &b) {
+  IntList::const_iterator aa, bb;
 
   aa = a.begin();
   bb = b.begin();
@@ -245,8 +274,8 @@ bool GTrieNode::_is_intset_included(list<int> a, list<int> b) {
 
 
 // Assume a and b are in ascending order
-bool GTrieNode::_is_pairset_included(list<iPair> a, list<iPair> b) {
-  list<iPair>::iterator aa, bb;
+bool GTrieNode::_is_pairset_included(const PairList &a, const PairList &b) {
+  PairList::const_iterator aa, bb;
 
   aa = a.begin();
   bb = b.begin();
@@ -270,10 +299,9 @@ void GTrieNode::insertConditionsFiltered(list<iPair> *conditions) {
   // Already has "empty set" of conditions
   if (cond_ok && cond_this_ok) return;
 
-  list<iPair> aux;
-  list<int>   aux_this_node;
-  list<iPair>::iterator jj, kk;
-  iPair p;
+  PairList aux;
+  IntList  aux_this_node;
+  list<iPair>::iterator jj;
 
 
   /*for (jj=conditions->begin(); jj!=conditions->end(); jj++)
@@ -281,18 +309,7 @@ void GTrieNode::insertConditionsFiltered(list<iPair> *conditions) {
     putchar('\n');*/
   
 
-  // A bit slow but works (search a<b and b<c: remove a<c)
-  for (jj=conditions->begin(); jj!=conditions->end(); jj++)
-    for (kk=conditions->begin(); kk!=conditions->end(); kk++)
-      if (jj->second == kk->first) {
-	p.first  = jj->first;
-	p.second = kk->second;
-	conditions->remove(p); // does not invalidade jj and kk
-      }
-
-  /*for (jj=conditions->begin(); jj!=conditions->end(); jj++)
-    printf("%d < %d  |  ", jj->first, jj->second);
-    putchar('\n');*/
+  // Transitive conditions were already removed (see _reduceConditions)
 
   for (jj=conditions->begin(); jj!=conditions->end(); jj++) {
     if (max(jj->first, jj->second)<=depth-1) // HERE!
@@ -309,7 +326,7 @@ void GTrieNode::insertConditionsFiltered(list<iPair> *conditions) {
       cond.clear();
     } else {
 
-      list< list<iPair> >::iterator mm;
+      CondList::iterator mm;
       bool is_contained = false;
       // A bit slow, but saves a lot of conditions
       for (mm=cond.begin(); mm!=cond.end();) {
@@ -325,7 +342,7 @@ void GTrieNode::insertConditionsFiltered(list<iPair> *conditions) {
 	else mm++;
       }
 
-      if (!is_contained) cond.push_back(aux);
+      if (!is_contained) cond.push_back(PairList(aux.begin(), aux.end(), ArenaAllocator<iPair>(_arena)));
       //else printf("avoid insertion (ancestors)!\n");
     }
   }
@@ -340,7 +357,7 @@ void GTrieNode::insertConditionsFiltered(list<iPair> *conditions) {
       this_node_cond.clear();
       } else {
     
-      list< list<int> >::iterator mm;
+      IntListList::iterator mm;
 
       bool is_contained = false;
       // A bit slow, but saves a lot of conditions
@@ -355,7 +372,7 @@ void GTrieNode::insertConditionsFiltered(list<iPair> *conditions) {
        }
       }
 
-      if (!is_contained) this_node_cond.push_back(aux_this_node);
+      if (!is_contained) this_node_cond.push_back(IntList(aux_this_node.begin(), aux_this_node.end(), ArenaAllocator<int>(_arena)));
       //else printf("avoid insertion (this_node)!\n");      
     }
   }
@@ -366,7 +383,7 @@ void GTrieNode::insertConditionsFiltered(list<iPair> *conditions) {
 int GTrieNode::countNodes() {
   int aux=1;
   
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     aux += (*ii)->countNodes();
 
@@ -376,7 +393,7 @@ int GTrieNode::countNodes() {
 void GTrieNode::zeroFrequency() {
   frequency = 0;
   
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     (*ii)->zeroFrequency();
 }
@@ -384,14 +401,14 @@ void GTrieNode::zeroFrequency() {
 void GTrieNode::showFrequency() {
   if (is_graph) printf("%d \n", frequency);
   
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     (*ii)->showFrequency();
 }
 
 int GTrieNode::maxDepth() {
   int aux = 0;
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     aux=max(aux, 1+(*ii)->maxDepth());
   return aux;
@@ -399,16 +416,93 @@ int GTrieNode::maxDepth() {
 
 
 
-void GTrieNode::goCondUndir() {  
+// Choose the connected ancestor with less neighbours >= mylim.
+// On large lists the first candidate is found by binary search.
+// Small lists are kept whole (the caller still stops below mylim).
+// Returns the number of candidates, starting at 'first', and the chosen
+// position of conn[] on 'who'
+int GTrieNode::_candidates(CensusState *st, int mylim, int **first, int *who) {
+  int i, v, n, best;
+  int *a, *s;
+  int *mymap = st->mymap, **fastnei = st->fastnei, *numnei = st->numnei;
+
+  best = INT_MAX;
+  for (i=0; i<nconn; i++) {
+    v = mymap[conn[i]];
+    a = fastnei[v];
+    if (mylim == 0 || numnei[v] <= SEARCH_LINEAR) s = a;
+    else s = lower_bound(a, a+numnei[v], mylim);
+    n = numnei[v] - (s-a);
+    if (n < best) {
+      best   = n;
+      *first = s;
+      *who   = i;
+    }
+  }
+
+  return best;
+}
+
+// Reduce the 'ncand' candidates starting at 'first' (taken from conn[who])
+// to the ones >= mylim that are neighbours of all connected ancestors
+int GTrieNode::_intersectCandidates(CensusState *st, int mylim, int **first, int ncand, int who) {
+  int i, v, n;
+  int *a, *s, *c = st->candbuf[depth-1];
+  int *mymap = st->mymap, **fastnei = st->fastnei, *numnei = st->numnei;
+
+  s = lower_bound(*first, *first+ncand, mylim);
+  n = *first+ncand-s;
+  memcpy(c, s, n*sizeof(int));
+
+  for (i=0; i<nconn && n>0; i++) {
+    if (i==who) continue;
+    v = mymap[conn[i]];
+    a = fastnei[v];
+    s = lower_bound(a, a+numnei[v], mylim);
+    n = SetOps::intersect(c, n, s, a+numnei[v]-s, c);
+  }
+
+  *first = c;
+  return n;
+}
+
+// Write the occurrence matched up to this node (adjacency matrix and labels)
+// to the occurrences file and/or index
+void GTrieNode::_writeOccurrence(CensusState *st) {
+  int k, l, lab[depth], *mymap = st->mymap;
+  char s[depth*depth+1];
+  bool **adjM = st->adjM;
+
+  for (k=0; k<depth; k++) {
+    for (l=0; l<depth; l++)
+      s[k*depth+l] = adjM[mymap[k]][mymap[l]]?'1':'0';
+    lab[k] = st->labels==NULL ? mymap[k] : st->labels[mymap[k]]-1;
+  }
+  s[depth*depth] = 0;
+  if (st->index != NULL) st->index->add(s, lab);
+  if (st->occ == NULL) return;
+
+  fputs(s, st->occ);
+  fputc(':', st->occ);
+  for (k=0; k<depth; k++) {
+    if (st->names==NULL) fprintf(st->occ, " %d", lab[k]+1);
+    else                 fprintf(st->occ, " %s", st->names[lab[k]].c_str());
+  }
+  fputc('\n', st->occ);
+}
+
+void GTrieNode::goCondUndir(CensusState *st) {  
   int i, j, ci, mylim, glaux;
   int ncand;
   int *p;
+  int glk = depth-1, *mymap = st->mymap;
+  bool *used = st->used, **adjM = st->adjM;
 
   mylim = INT_MAX;
   if (!cond_ok) {
     i = 1;
-    list< list<iPair> >::const_iterator jj, jjend;
-    list<iPair>::const_iterator kk, kkend;
+    CondList::const_iterator jj, jjend;
+    PairList::const_iterator kk, kkend;
     for (jj=cond.begin(), jjend=cond.end(); jj!=jjend; ++jj) {
       glaux = -1;
       for (kk=(*jj).begin(), kkend=(*jj).end(); kk!=kkend; ++kk)
@@ -425,19 +519,9 @@ void GTrieNode::goCondUndir() {
   }
   if (mylim == INT_MAX) mylim = 0;
     
-  ncand=0;
-  j=ci=INT_MAX;
-  for (i=0; i<nconn; i++) {
-    glaux = numnei[mymap[conn[i]]];
-    if (glaux<j) {
-      ci = mymap[conn[i]];
-      j = glaux;
-    }
-  }
-
-  glaux = j;
-  ncand = ci;
-  for (p=&fastnei[ncand][j-1], ci= glaux-1; ci>=0; ci--, p--) {    
+  ncand = _candidates(st, mylim, &p, &ci);
+  if (st->intersect && nconn>1) ncand = _intersectCandidates(st, mylim, &p, ncand, ci);
+  for (p+=ncand-1, ci=ncand-1; ci>=0; ci--, p--) {
     i = *p;
     if (i<mylim) break;
     if (used[i]) continue;
@@ -448,41 +532,39 @@ void GTrieNode::goCondUndir() {
       if (out[j] != *(b+mymap[j]))
 	break;
     if (j<glk) continue;
+
+    // A seed must be close enough to be reached with the nodes left
+    if (st->seedDist != NULL) {
+      st->near[glk] = min(st->near[glk-1], st->seedDist[i]);
+      if (st->near[glk] > st->size-depth) continue;
+    }
     
-    if (is_graph) {
+    if (is_graph && (st->seedDist == NULL || st->near[glk] == 0)) {
       frequency++;
-      if (Global::show_occ) {
-	for (int k = 0; k<=glk; k++)
-	  for (int l = 0; l<=glk; l++)
-	    fputc(adjM[mymap[k]][mymap[l]]?'1':'0', Global::occ_file);
-	fputc(':', Global::occ_file);
-	for (int k = 0; k<=glk; k++)
-	  fprintf(Global::occ_file, " %d", mymap[k]+1);
-	fputc('\n', Global::occ_file);
-      }
+      if (st->occ != NULL || st->index != NULL) _writeOccurrence(st);
     }
 
     used[i]=true;
-    glk++;
-    list<GTrieNode *>::const_iterator ii, iiend;
+    ChildList::const_iterator ii, iiend;
     for(ii=child.begin(), iiend = child.end(); ii!=iiend; ++ii)
-      (*ii)->goCondUndir();
-    glk--;
+      (*ii)->goCondUndir(st);
     used[i]=false;
   }
 }
 
 
-void GTrieNode::goCondDir() {  
+void GTrieNode::goCondDir(CensusState *st) {  
   int i, j, ci, mylim, glaux;
   int ncand;
   int *p;
+  int glk = depth-1, *mymap = st->mymap;
+  bool *used = st->used, **adjM = st->adjM;
 
   mylim = INT_MAX;
   if (!cond_ok) {
     i = 1;
-    list< list<iPair> >::const_iterator jj, jjend;
-    list<iPair>::const_iterator kk, kkend;
+    CondList::const_iterator jj, jjend;
+    PairList::const_iterator kk, kkend;
     for (jj=cond.begin(), jjend=cond.end(); jj!=jjend; ++jj) {
       glaux = -1;
       for (kk=(*jj).begin(), kkend=(*jj).end(); kk!=kkend; ++kk)
@@ -499,19 +581,9 @@ void GTrieNode::goCondDir() {
   }
   if (mylim == INT_MAX) mylim = 0;
     
-  ncand=0;
-  j=ci=INT_MAX;
-  for (i=0; i<nconn; i++) {
-    glaux = numnei[mymap[conn[i]]];
-    if (glaux<j) {
-      ci = mymap[conn[i]];
-      j = glaux;
-    }
-  }
-
-  glaux = j;
-  ncand = ci;
-  for (p=&fastnei[ncand][j-1], ci= glaux-1; ci>=0; ci--, p--) {    
+  ncand = _candidates(st, mylim, &p, &ci);
+  if (st->intersect && nconn>1) ncand = _intersectCandidates(st, mylim, &p, ncand, ci);
+  for (p+=ncand-1, ci=ncand-1; ci>=0; ci--, p--) {
     i = *p;
     if (i<mylim) break;
     if (used[i]) continue;
@@ -526,26 +598,22 @@ void GTrieNode::goCondDir() {
       if (out[j] != *(b+mymap[j]))
 	break;
     if (j<glk) continue;
+
+    // A seed must be close enough to be reached with the nodes left
+    if (st->seedDist != NULL) {
+      st->near[glk] = min(st->near[glk-1], st->seedDist[i]);
+      if (st->near[glk] > st->size-depth) continue;
+    }
     
-    if (is_graph) {
+    if (is_graph && (st->seedDist == NULL || st->near[glk] == 0)) {
       frequency++;
-      if (Global::show_occ) {
-	for (int k = 0; k<=glk; k++)
-	  for (int l = 0; l<=glk; l++)
-	    fputc(adjM[mymap[k]][mymap[l]]?'1':'0', Global::occ_file);
-	fputc(':', Global::occ_file);
-	for (int k = 0; k<=glk; k++)
-	  fprintf(Global::occ_file, " %d", mymap[k]+1);
-	fputc('\n', Global::occ_file);
-      }
+      if (st->occ != NULL || st->index != NULL) _writeOccurrence(st);
     }
 
     used[i]=true;
-    glk++;
-    list<GTrieNode *>::const_iterator ii, iiend;
+    ChildList::const_iterator ii, iiend;
     for(ii=child.begin(), iiend = child.end(); ii!=iiend; ++ii)
-      (*ii)->goCondDir();
-    glk--;
+      (*ii)->goCondDir(st);
     used[i]=false;
   }
 }
@@ -556,7 +624,7 @@ int GTrieNode::countGraphsApp() {
   int aux=0;
   if (is_graph && frequency>0) aux++;
   
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     aux += (*ii)->countGraphsApp();
 
@@ -567,7 +635,7 @@ int GTrieNode::countGraphs() {
   int aux=0;
   if (is_graph) aux=1;
   
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     aux += (*ii)->countGraphs();
 
@@ -578,7 +646,7 @@ int GTrieNode::countGraphPaths() {
   int aux=0;
   if (is_graph) aux=depth;
   
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     aux += (*ii)->countGraphPaths();
 
@@ -589,7 +657,7 @@ double GTrieNode::countOccurrences() {
   double aux=0;
   if (is_graph && frequency>0) aux+=frequency;
   
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     aux += (*ii)->countOccurrences();
 
@@ -648,8 +716,8 @@ void GTrieNode::writeToFile(FILE *f) {
   fputc(BASE_FIRST+aux, f);
 
   if (aux>0) {
-    list< list<iPair> >::const_iterator jj, jjend;
-    list<iPair>::const_iterator kk, kkend;
+    CondList::const_iterator jj, jjend;
+    PairList::const_iterator kk, kkend;
     for (jj=cond.begin(), jjend=cond.end(); jj!=jjend; ++jj) {      
       for (kk=(*jj).begin(), kkend=(*jj).end(); kk!=kkend; ++kk) {
 	fputc(BASE_FIRST+1+(kk->first),f);
@@ -661,19 +729,19 @@ void GTrieNode::writeToFile(FILE *f) {
   
   fputc('\n', f);
 
-  list<GTrieNode *>::iterator ii;
+  ChildList::iterator ii;
   for(ii=child.begin(); ii!=child.end(); ii++)
     (*ii)->writeToFile(f);
 
 }
 
-void GTrieNode::readFromFile(FILE *f) {
+void GTrieNode::readFromFile(FILE *f, LineBuffer *l) {
   int nchilds, i, j, pos, bits, ncond;
   iPair p;
-  char aux, buf[MAX_BUF];
+  char aux, *buf;
   GTrieNode *c;
 
-  if (fgets(buf, MAX_BUF, f)) {
+  if ((buf = _readLine(f, l)) != NULL) {
     aux = buf[0]-BASE_FIRST;
     if (BIT_VALUE(aux, 0)) is_graph=true;
     else                   is_graph=false;
@@ -716,7 +784,7 @@ void GTrieNode::readFromFile(FILE *f) {
     if (aux>0) {
       ncond = aux;
       for (i=0; i<ncond; i++) {
-	list<iPair> newcond;
+	PairList newcond((ArenaAllocator<iPair>(_arena)));
 	while(1) {
 	  aux = buf[pos++]-BASE_FIRST-1;
 	  if (aux<0) break;
@@ -744,8 +812,8 @@ void GTrieNode::readFromFile(FILE *f) {
     
     
     for (i=0; i<nchilds; i++) {
-      c = new GTrieNode(depth+1);
-      c->readFromFile(f);
+      c = _newChild();
+      c->readFromFile(f, l);
       child.push_back(c);
     }
 
@@ -753,6 +821,73 @@ void GTrieNode::readFromFile(FILE *f) {
 
 }
 
+// Store this node on 't' (children are placed by the caller)
+void GTrieNode::writeToTable(GTrieFileNode *t, vector<int> &pool) {
+  int i;
+
+  memset(t, 0, sizeof(GTrieFileNode));
+  t->depth    = depth;
+  t->is_graph = is_graph;
+  for (i=0; i<depth; i++) {
+    if (out[i]) t->out |= 1ULL<<i;
+    if (in[i])  t->in  |= 1ULL<<i;
+  }
+  t->nchild = child.size();
+  t->cond   = pool.size();
+  t->ncond  = cond_ok ? 0 : cond.size();
+
+  if (t->ncond>0) {
+    CondList::const_iterator jj, jjend;
+    PairList::const_iterator kk, kkend;
+    for (jj=cond.begin(), jjend=cond.end(); jj!=jjend; ++jj) {
+      pool.push_back((*jj).size());
+      for (kk=(*jj).begin(), kkend=(*jj).end(); kk!=kkend; ++kk) {
+	pool.push_back(kk->first);
+	pool.push_back(kk->second);
+      }
+    }
+  }
+}
+
+// Set this node from 't' (entry 'i' of the table) and create its children on 'nodes'.
+// Conditions are checked to be between ancestors, as the census follows them
+void GTrieNode::readFromTable(const GTrieFileNode *t, int i, const int *pool, int npool,
+			      GTrieNode **nodes) {
+  int j, k, n, pos;
+  iPair p;
+
+  if (t->depth!=depth || depth>MAX_MOTIF_SIZE || t->cond<0 || t->ncond<0 || t->cond>npool)
+    Error::msg("Invalid g-trie node %d", i);
+
+  is_graph = t->is_graph;
+  for (j=0; j<depth; j++) {
+    out[j] = (t->out>>j)&1;
+    in[j]  = (t->in>>j)&1;
+    if (out[j] || in[j])
+      conn[nconn++] = j;
+  }
+
+  cond_ok = (t->ncond == 0);
+  for (j=0, pos=t->cond; j<t->ncond; j++) {
+    if (pos>=npool || pool[pos]<0 || pos+1+2LL*pool[pos]>npool)
+      Error::msg("Invalid g-trie conditions on node %d", i);
+    PairList newcond((ArenaAllocator<iPair>(_arena)));
+    for (k=0, n=pool[pos++]; k<n; k++, pos+=2) {
+      p.first  = pool[pos];
+      p.second = pool[pos+1];
+      if (p.first<0 || p.first>=depth || p.second<0 || p.second>=depth)
+	Error::msg("Invalid g-trie conditions on node %d", i);
+      newcond.push_back(p);
+    }
+    cond.push_back(newcond);
+  }
+
+  for (j=0; j<t->nchild; j++) {
+    nodes[t->first_child+j] = _newChild();
+    child.push_back(nodes[t->first_child+j]);
+  }
+}
+
 void GTrieNode::populateGraphTree(GraphTree *tree, char *s, int size) {
   int i, pos=depth-1;
   
@@ -764,7 +899,7 @@ void GTrieNode::populateGraphTree(GraphTree *tree, char *s, int size) {
   if (is_graph)
     tree->setString(s, frequency);
 
-  list<GTrieNode *>::const_iterator ii, iiend;
+  ChildList::const_iterator ii, iiend;
   for(ii=child.begin(), iiend = child.end(); ii!=iiend; ++ii)
     (*ii)->populateGraphTree(tree, s, size);
 }
@@ -780,23 +915,69 @@ void GTrieNode::populateMap(mapStringInt *m, char *s, int size) {
 
   if (is_graph && frequency>0) (*m)[s]=frequency;
 
-  list<GTrieNode *>::const_iterator ii, iiend;
+  ChildList::const_iterator ii, iiend;
   for(ii=child.begin(), iiend = child.end(); ii!=iiend; ++ii)
     (*ii)->populateMap(m, s, size);
 }
 
+// Store frequencies of subgraphs on 'v' (depth-first order), starting at 'pos'
+int GTrieNode::getFrequencies(int *v, int pos) {
+  if (is_graph) v[pos++] = frequency;
+
+  ChildList::const_iterator ii, iiend;
+  for(ii=child.begin(), iiend = child.end(); ii!=iiend; ++ii)
+    pos = (*ii)->getFrequencies(v, pos);
+  return pos;
+}
+
+// Read frequencies of subgraphs from 'v' (depth-first order), starting at 'pos'
+int GTrieNode::setFrequencies(int *v, int pos) {
+  if (is_graph) frequency = v[pos++];
+
+  ChildList::const_iterator ii, iiend;
+  for(ii=child.begin(), iiend = child.end(); ii!=iiend; ++ii)
+    pos = (*ii)->setFrequencies(v, pos);
+  return pos;
+}
+
 // -------------------------------------
 
 GTrie::GTrie() {
-  _root = new GTrieNode(0);
+  _root = new (_arena.alloc(sizeof(GTrieNode))) GTrieNode(0, &_arena);
   _root->cond_ok = _root->cond_this_ok = true;
 }
 
+// Nodes and their lists are all on the arena (no destructors to run)
 GTrie::~GTrie() {
-  delete _root;
+}
+
+// Remove transitive conditions (a<b and b<c: remove a<c), in list order.
+// Done once per subgraph, since removing again would not change the list
+static void _reduceConditions(list<iPair> *cond) {
+  int i, j, n = cond->size();
+  bool alive[MAX_MOTIF_SIZE][MAX_MOTIF_SIZE];
+  vector<iPair> v(cond->begin(), cond->end());
+  list<iPair>::iterator ii;
+
+  for (i=0; i<n; i++)
+    for (j=0; j<n; j++)
+      alive[v[i].first][v[j].second] = false;
+  for (i=0; i<n; i++)
+    alive[v[i].first][v[i].second] = true;
+
+  for (i=0; i<n; i++)
+    if (alive[v[i].first][v[i].second])
+      for (j=0; j<n; j++)
+	if (v[j].first == v[i].second && alive[v[j].first][v[j].second])
+	  alive[v[i].first][v[j].second] = false;
+
+  for (ii=cond->begin(); ii!=cond->end();)
+    if (alive[ii->first][ii->second]) ++ii;
+    else ii = cond->erase(ii);
 }
 
 void GTrie::insertGraphCond(Graph *g, list<iPair> *cond) {
+  _reduceConditions(cond);
   _root->insertCond(g, cond);
 }
 
@@ -838,21 +1019,89 @@ void GTrie::insertGraphString(int size, const char *s) {
 }
 
 // Populate g-trie with subgraphs of 'size' read from file 's'
+// Subgraph list being inserted in parallel
+typedef struct {
+  vector<string> *list;
+  int size;
+  bool dir;
+  GTrie *gt;
+} SubgraphsJob;
+
+// Canonical form and conditions of subgraphs [first, last) of the list
+static void _canonicalWork(int first, int last, FILE *out, void *arg) {
+  SubgraphsJob *job = (SubgraphsJob *)arg;
+  int i, n, size = job->size;
+  char larger[size*size+1];
+  list<iPair> cond;
+  list<iPair>::iterator ii;
+
+  for (i=first; i<last; i++) {
+    GTrie::canonicalConditions(size, (*job->list)[i].c_str(), job->dir, 1, larger, &cond);
+    n = cond.size();
+    fwrite(larger, 1, size*size, out);
+    fwrite(&n, sizeof(int), 1, out);
+    for (ii=cond.begin(); ii!=cond.end(); ++ii)
+      fwrite(&(*ii), sizeof(iPair), 1, out);
+  }
+}
+
+// Insert subgraphs as given by _canonicalWork
+static void _canonicalMerge(FILE *in, void *arg) {
+  SubgraphsJob *job = (SubgraphsJob *)arg;
+  int i, n, size = job->size;
+  char larger[size*size+1];
+  list<iPair> cond;
+  iPair p;
+
+  larger[size*size] = 0;
+  while (fread(larger, 1, size*size, in)==(size_t)(size*size)) {
+    if (fread(&n, sizeof(int), 1, in)!=1) Error::msg("Truncated subgraph results");
+    cond.clear();
+    for (i=0; i<n; i++) {
+      if (fread(&p, sizeof(iPair), 1, in)!=1) Error::msg("Truncated subgraph results");
+      cond.push_back(p);
+    }
+    job->gt->insertCanonical(size, larger, job->dir, &cond);
+  }
+}
+
 void GTrie::readSubgraphs(int size, bool dir, char *s) {
-  char buf[MAX_BUF];
+  char buf[MAX_MOTIF_SIZE*MAX_MOTIF_SIZE+1];
+  vector<string> v;
 
   FILE *f = fopen(s, "r");
   if (!f) Error::msg(NULL);
-  while (fscanf(f, "%s", buf)==1) {
-    insertGraphNautyString(size, buf, dir, 1);
-  }
+  while (fscanf(f, "%s", buf)==1)
+    v.push_back(buf);
   fclose(f);
+  insertSubgraphs(size, dir, v);
+}
+
+// Insert all subgraphs of 'v' (adjacency strings). With more than one job,
+// subgraphs are canonized in parallel and inserted in the order of 'v'
+// (so the g-trie is always the same)
+void GTrie::insertSubgraphs(int size, bool dir, vector<string> &v) {
+  if (Parallel::jobs()<=1) {
+    for (int i=0; i<(int)v.size(); i++)
+      insertGraphNautyString(size, v[i].c_str(), dir, 1);
+  } else {
+    SubgraphsJob job = {&v, size, dir, this};
+    Parallel::run(v.size(), _canonicalWork, _canonicalMerge, &job);
+  }
   cleanConditions();  
 }
 
 void GTrie::insertGraphNautyString(int size, const char *s, bool dir, int label) {
   char larger[size*size+1];
+  list<iPair> cond;
+
+  canonicalConditions(size, s, dir, label, larger, &cond);
+  insertCanonical(size, larger, dir, &cond);
+}
 
+// Canonical form of 's' (written to 'larger') and its symmetry conditions
+void GTrie::canonicalConditions(int size, const char *s, bool dir, int label,
+				char *larger, list<iPair> *cond) {
   if (label==2)
     Isomorphism::canonicalBigger(s, larger, size);
   else if (label==3)
@@ -868,13 +1117,19 @@ void GTrie::insertGraphNautyString(int size, const char *s, bool dir, int label)
   else      GraphUtils::strToGraph(g, larger, size, UNDIRECTED);
 
   g->makeArrayNeighbours();
-
-  list<iPair> *cond = new list<iPair>;
   Conditions::symmetryConditions(g, cond);  
+  delete g;
+}
 
-  insertGraphCond(g, cond);
+// Insert canonical subgraph 'larger' with conditions 'cond'
+void GTrie::insertCanonical(int size, const char *larger, bool dir, list<iPair> *cond) {
+  Graph *g = new GraphMatrix();
 
-  delete cond;
+  if (dir)  GraphUtils::strToGraph(g, larger, size, DIRECTED);
+  else      GraphUtils::strToGraph(g, larger, size, UNDIRECTED);
+
+  g->makeArrayNeighbours();
+  insertGraphCond(g, cond);
   delete g;
 }
 
@@ -893,42 +1148,93 @@ void GTrie::showFrequency() {
 }
 
 void GTrie::census(Graph *g) {
+  CensusOptions o;
+  memset(&o, 0, sizeof(CensusOptions));
+  census(g, &o);
+}
+
+// Prepare state 'st' for a census of 'g' with subgraphs up to 'size' nodes
+void GTrie::_censusBegin(Graph *g, int size, bool intersect, CensusState *st) {
+  int i, num_nodes = g->numNodes();
+
+  st->mymap    = new int[size];
+  st->used     = new bool[num_nodes];
+  st->numNodes = num_nodes;
+  st->fastnei  = g->matrixNeighbours();
+  st->adjM     = g->adjacencyMatrix();
+  st->numnei   = g->arrayNumNeighbours(); 
+  st->intersect = intersect;
+  st->candbuf   = NULL;
+  if (intersect) {
+    int maxnei = 0;
+    for (i=0; i<num_nodes; i++)
+      maxnei = max(maxnei, st->numnei[i]);
+    st->candbuf = new int*[size];
+    for (i=0; i<size; i++)
+      st->candbuf[i] = new int[maxnei];
+  }
+  st->isdir  = (g->type() == DIRECTED);
+  st->prob   = NULL;
+  st->occ    = NULL;
+  st->index  = NULL;
+  st->labels = NULL;
+  st->names  = NULL;
+  st->seedDist = NULL;
+  st->near   = new int[size];
+  st->size   = size;
+  for (i=0; i<num_nodes; i++)
+    st->used[i]=false;
+}
+
+void GTrie::_censusEnd(int size, CensusState *st) {
+  delete [] st->mymap;
+  delete [] st->used;
+  delete [] st->near;
+  if (st->candbuf != NULL) {
+    for (int i=0; i<size; i++)
+      delete [] st->candbuf[i];
+    delete [] st->candbuf;
+  }
+}
+
+// Census with options 'o' (frequencies are kept when o->first>0).
+// All the state of the census is local, so censuses on different
+// g-tries can run at the same time
+void GTrie::census(Graph *g, const CensusOptions *o) {
   int i;
   int subgraph_size = maxDepth();
   int num_nodes = g->numNodes();
+  CensusState st;
 
-  _root->zeroFrequency();
-  
-  GTrieNode::mymap = new int[subgraph_size];
-  GTrieNode::used  = new bool[num_nodes];
-  GTrieNode::numNodes = num_nodes;
-  GTrieNode::fastnei  = g->matrixNeighbours();
-  GTrieNode::adjM     = g->adjacencyMatrix();
-  GTrieNode::numnei   = g->arrayNumNeighbours(); 
-  
-  if (g->type() == DIRECTED) GTrieNode::isdir = true;
-  else                       GTrieNode::isdir = false;
-  for (i=0; i<num_nodes; i++)
-    GTrieNode::used[i]=false;
+  if (o->first == 0) _root->zeroFrequency();
+  if (_root->child.empty()) return; // no subgraphs
+  _censusBegin(g, subgraph_size, o->intersect, &st);
+  st.occ    = o->occ;
+  st.index  = o->index;
+  st.labels = o->labels;
+  st.names  = o->names;
+  st.seedDist = o->seedDist;
 
   GTrieNode *c = *(_root->child.begin());
-  list<GTrieNode *>::iterator ii;
-  GTrieNode::glk=1;
-
-  for (i = 0; i<num_nodes; i++) {
-    GTrieNode::mymap[0] = i;
-    GTrieNode::used[i]=true;
-    if (g->type() == DIRECTED)
+  ChildList::iterator ii;
+
+  for (i = o->first; i<num_nodes; i++) {
+    if (o->roots != NULL && !o->roots[i]) continue;
+    if (o->seedDist != NULL && o->seedDist[i] >= subgraph_size) continue;
+    st.near[0] = o->seedDist != NULL ? o->seedDist[i] : 0;
+    st.mymap[0] = i;
+    st.used[i]=true;
+    if (st.isdir)
       for(ii=c->child.begin(); ii!=c->child.end(); ii++)
-	(*ii)->goCondDir();
+	(*ii)->goCondDir(&st);
     else
       for(ii=c->child.begin(); ii!=c->child.end(); ii++)
-	(*ii)->goCondUndir();
-    GTrieNode::used[i]=false;
+	(*ii)->goCondUndir(&st);
+    st.used[i]=false;
+    if (o->progress != NULL) o->progress(i+1, this);
   }
-        
-  delete [] GTrieNode::mymap;
-  delete [] GTrieNode::used;
+
+  _censusEnd(subgraph_size, &st);
 }
 
 double GTrie::countOccurrences() {
@@ -957,13 +1263,111 @@ void GTrie::writeToFile(char *s) {
 
 void GTrie::readFromFile(char *s) {
   FILE *f;
-  char *dummy, buf[MAX_BUF];
+
+  if (isBinary(s)) {
+    _readBinary(s);
+    return;
+  }
   
+  LineBuffer l = {NULL, 0};
   f=fopen(s,"r");
   if (!f) Error::msg(NULL);
-  dummy=fgets(buf, MAX_BUF, f);
-  _root->readFromFile(f);
+  _readLine(f, &l);
+  _root->readFromFile(f, &l);
+  fclose(f);
+  free(l.buf);
+}
+
+// Does file 's' start with the binary g-trie magic?
+bool GTrie::isBinary(char *s) {
+  char magic[8];
+  bool bin;
+
+  FILE *f = fopen(s, "rb");
+  if (f==NULL) Error::msg("Unable to open g-trie file \"%s\"", s);
+  bin = fread(magic, 1, 8, f)==8 && !memcmp(magic, GTRIE_BIN_MAGIC, 8);
   fclose(f);
+  return bin;
+}
+
+// Write the g-trie as a flat node table (see GTrieFileNode)
+void GTrie::writeBinary(char *s) {
+  vector<GTrieNode *> q;
+  vector<GTrieFileNode> table;
+  vector<int> pool;
+  GTrieFileHeader h;
+  int i;
+
+  // Breadth-first, so that the children of each node are contiguous
+  q.push_back(_root);
+  for (i=0; i<(int)q.size(); i++) {
+    table.resize(i+1);
+    q[i]->writeToTable(&table[i], pool);
+    table[i].first_child = q.size();
+    q.insert(q.end(), q[i]->child.begin(), q[i]->child.end());
+  }
+
+  memset(&h, 0, sizeof(GTrieFileHeader));
+  h.version = GTRIE_BIN_VERSION;
+  h.nodes   = table.size();
+  h.pool    = pool.size();
+
+  FILE *f = fopen(s, "wb");
+  if (f==NULL) Error::msg("Unable to open g-trie output file \"%s\"", s);
+  fwrite(GTRIE_BIN_MAGIC, 1, 8, f);
+  fwrite(&h, sizeof(GTrieFileHeader), 1, f);
+  fwrite(&table[0], sizeof(GTrieFileNode), h.nodes, f);
+  if (h.pool>0) fwrite(&pool[0], sizeof(int), h.pool, f);
+  if (fclose(f)!=0) Error::msg(NULL);
+}
+
+// Map a binary g-trie file and build all nodes in one pass over its table.
+// The table is read in place (it is 8-byte aligned), but the census still
+// works on the node tree built from it
+void GTrie::_readBinary(char *s) {
+  struct stat st;
+  GTrieFileHeader h;
+  const GTrieFileNode *t;
+  char *m;
+  int i, next;
+
+  int fd = open(s, O_RDONLY);
+  if (fd<0 || fstat(fd, &st)!=0) Error::msg("Unable to open g-trie file \"%s\"", s);
+  if ((size_t)st.st_size < 8+sizeof(GTrieFileHeader)) {
+    close(fd);
+    Error::msg("Invalid g-trie file \"%s\"", s);
+  }
+  m = (char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (m==MAP_FAILED) Error::msg(NULL);
+
+  memcpy(&h, m+8, sizeof(GTrieFileHeader));
+  if (h.version!=GTRIE_BIN_VERSION || h.nodes<1 || h.pool<0 ||
+      (unsigned long long)st.st_size != 8+sizeof(GTrieFileHeader)+
+      (unsigned long long)h.nodes*sizeof(GTrieFileNode)+(unsigned long long)h.pool*sizeof(int)) {
+    munmap(m, st.st_size);
+    Error::msg("Invalid g-trie file \"%s\" (version %d)", s, h.version);
+  }
+
+  const GTrieFileNode *table = (const GTrieFileNode *)(m+8+sizeof(GTrieFileHeader));
+  const int *pool = (const int *)(table+h.nodes);
+  madvise(m, st.st_size, MADV_SEQUENTIAL);
+
+  vector<GTrieNode *> nodes(h.nodes);
+  nodes[0] = _root;
+  try {
+    for (i=0, next=1; i<h.nodes; i++) {
+      t = &table[i];
+      if (i>=next || t->first_child!=next || t->nchild<0 || t->nchild > h.nodes-next)
+	Error::msg("Invalid g-trie node %d", i);
+      next += t->nchild;
+      nodes[i]->readFromTable(t, i, pool, h.pool, &nodes[0]);
+    }
+  } catch (ErrorException &) { // thrown errors (see Error::setThrow)
+    munmap(m, st.st_size);
+    throw;
+  }
+  munmap(m, st.st_size);
 }
 
 void GTrie::populateGraphTree(GraphTree *tree, int size) {
@@ -978,44 +1382,43 @@ void GTrie::populateMap(mapStringInt *m, int size) {
   _root->populateMap(m, s, size);
 }
 
+void GTrie::getFrequencies(int *v) {
+  _root->getFrequencies(v, 0);
+}
+
+void GTrie::setFrequencies(int *v) {
+  _root->setFrequencies(v, 0);
+}
+
 
 void GTrie::censusSample(Graph *g, double *p) {
-  int i;
   int subgraph_size = maxDepth();
-  int num_nodes = g->numNodes();
+  CensusState st;
 
   _root->zeroFrequency();
-  
-  GTrieNode::mymap = new int[subgraph_size];
-  GTrieNode::used  = new bool[num_nodes];
-  GTrieNode::numNodes = num_nodes;
-  GTrieNode::fastnei  = g->matrixNeighbours();
-  GTrieNode::adjM     = g->adjacencyMatrix();
-  GTrieNode::numnei   = g->arrayNumNeighbours(); 
-  GTrieNode::prob     = p;
-
-  if (g->type() == DIRECTED) GTrieNode::isdir = true;
-  else                       GTrieNode::isdir = false;
-  for (i=0; i<num_nodes; i++)
-    GTrieNode::used[i]=false;
+  _censusBegin(g, subgraph_size, false, &st);
+  st.prob = p;
 
-
-  list<GTrieNode *>::iterator ii, iiend;
-  GTrieNode::glk=0;
+  ChildList::iterator ii, iiend;
   for(ii=_root->child.begin(), iiend = _root->child.end(); ii!=iiend; ii++)
-    if (Random::getDouble()<=GTrieNode::prob[0]) {
-      (*ii)->goCondSample();
+    if (Random::getDouble()<=st.prob[0]) {
+      (*ii)->goCondSample(&st);
     }
+
+  _censusEnd(subgraph_size, &st);
 }
 
 
-void GTrieNode::goCondSample() {
+void GTrieNode::goCondSample(CensusState *st) {
   int i, j, ci, mylim, glaux;
   int ncand;
+  int glk = depth-1, *mymap = st->mymap, **fastnei = st->fastnei, *numnei = st->numnei;
+  int numNodes = st->numNodes;
+  bool *used = st->used, **adjM = st->adjM;
 
   if (!cond_ok) {
-    list< list<iPair> >::const_iterator jj, jjend;
-    list<iPair>::const_iterator kk, kkend;
+    CondList::const_iterator jj, jjend;
+    PairList::const_iterator kk, kkend;
     for (jj=cond.begin(), jjend=cond.end(); jj!=jjend; ++jj) {
       for (kk=(*jj).begin(), kkend=(*jj).end(); kk!=kkend; ++kk)
 	if ( mymap[kk->first]>mymap[kk->second])
@@ -1055,8 +1458,8 @@ void GTrieNode::goCondSample() {
 
   if (cond_this_ok) mylim = 0;
   else {
-    list< list<int> >::const_iterator jjj;
-    list<int>::const_iterator kkk;
+    IntListList::const_iterator jjj;
+    IntList::const_iterator kkk;
     mylim = INT_MAX;
     for (jjj=this_node_cond.begin(); jjj!=this_node_cond.end(); ++jjj) {
       glaux = -1;
@@ -1071,7 +1474,7 @@ void GTrieNode::goCondSample() {
     if (i<mylim) break;
     mymap[glk] = i;
 
-    if (isdir) {  
+    if (st->isdir) {  
       for (j=0; j<glk; j++)
 	if (in[j]  != adjM[mymap[j]][i] ||
 	    out[j] != adjM[i][mymap[j]])
@@ -1084,33 +1487,23 @@ void GTrieNode::goCondSample() {
     if (j<glk) continue;
 
     if (is_graph) {      
-      if (Global::show_occ) {
-	for (int k = 0; k<=glk; k++)
-	  for (int l = 0; l<=glk; l++)
-	    fputc(adjM[mymap[k]][mymap[l]]?'1':'0', Global::occ_file);
-	fputc(':', Global::occ_file);
-	for (int k = 0; k<=glk; k++)
-	  fprintf(Global::occ_file, " %d", mymap[k]+1);
-	fputc('\n', Global::occ_file);
-      }
+      if (st->occ != NULL || st->index != NULL) _writeOccurrence(st);
       frequency++;
     }
 
     used[i]=true;
-    glk++;
-    list<GTrieNode *>::const_iterator ii, iiend;
+    ChildList::const_iterator ii, iiend;
     for(ii=child.begin(), iiend = child.end(); ii!=iiend; ++ii)
-      if (Random::getDouble() <= prob[glk]) {
-	(*ii)->goCondSample();
+      if (Random::getDouble() <= st->prob[depth]) {
+	(*ii)->goCondSample(st);
       }
-    glk--;
     used[i]=false;
   }
 }
 
 void GTrieNode::clean(int a, int b) {
-  list< list<iPair> >::iterator ii;
-  list<iPair> ::iterator jj;
+  CondList::iterator ii;
+  PairList::iterator jj;
 
   if (cond.size()>0) {
 
@@ -1127,7 +1520,7 @@ void GTrieNode::clean(int a, int b) {
     }    
   }
 
-  list<GTrieNode *>::iterator cc;
+  ChildList::iterator cc;
   for(cc=child.begin(); cc!=child.end(); cc++)
     (*cc)->clean(a, b);	
 
@@ -1135,8 +1528,8 @@ void GTrieNode::clean(int a, int b) {
 
 void GTrieNode::cleanConditions() {
   int a, b;
-  list< list<iPair> >::iterator ii;
-  list<iPair> ::iterator jj, kk;
+  CondList::iterator ii;
+  PairList::iterator jj, kk;
 
   if (cond.size()>0) {
     for (jj=cond.begin()->begin(); jj!=cond.begin()->end();jj++) {
@@ -1148,14 +1541,14 @@ void GTrieNode::cleanConditions() {
 	if (kk==ii->end()) break;
       }
       if (ii==cond.end())  {
-	list<GTrieNode *>::iterator ii;
+	ChildList::iterator ii;
 	for(ii=child.begin(); ii!=child.end(); ii++)
 	  (*ii)->clean(a, b);	
       }
     }
   }
 
-  list<GTrieNode *>::iterator cc;
+  ChildList::iterator cc;
   for(cc=child.begin(); cc!=child.end(); cc++)
     (*cc)->cleanConditions();
 }
@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 G-Trie Implementation and associated methods
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #ifndef _GTRIE_
@@ -22,34 +22,123 @@ Last Update: 11/02/2012
 
 #include "Common.h"
 #include "Graph.h"
+#include "Arena.h"
+#include <unordered_map>
 
 #define BASE_FORMAT      95
 #define BASE_FIRST       ' '
 #define BASE_BITS        6
 
+#define SEARCH_LINEAR    32 // Neighbour lists up to this size are not binary searched
+#define CHILD_LINEAR      8 // Children of a node are hashed when they are more than this
+
+#define GTRIE_BIN_MAGIC   "GTRIEBIN" // First bytes of a binary g-trie file
+#define GTRIE_BIN_VERSION 2
+
+// Node of a binary g-trie file. Nodes are stored in breadth-first order
+// (root first), so the children of a node are a contiguous range
+typedef struct {
+  unsigned long long out; // Outward edges (bit i: edge to ancestor i)
+  unsigned long long in;  // Inward edges
+  int depth;
+  int is_graph;
+  int first_child;        // Index of first child
+  int nchild;             // Number of children
+  int cond;               // Start of conditions on the condition pool
+  int ncond;              // Number of conditions (0: no need to check)
+} GTrieFileNode;
+
+// The condition pool has, for each condition, its number of pairs
+// followed by the pairs themselves
+typedef struct {
+  int version;
+  int nodes;              // Number of nodes
+  int pool;               // Size of the condition pool (ints)
+  int reserved;           // (keeps the node table, after the magic, 8-byte aligned)
+} GTrieFileHeader;
+
 class GraphTree; // forward declaration
+class GTrieNode;
+class GTrie;
+
+// Options of a census (all zero: count everything, no occurrences)
+typedef struct {
+  bool intersect;      // Intersect neighbours of connected ancestors (see '-ix')
+  FILE *occ;           // Write occurrences here (NULL: do not)
+  OccIndex *index;     // Add occurrences to this index (NULL: do not)
+  const int *labels;   // Label of each node on occurrences (NULL: node number+1)
+  const string *names; // Identifier of each label on occurrences (NULL: the label)
+  const bool *roots;   // Only count subgraphs rooted on these nodes (NULL: all)
+  int first;           // First root (frequencies are kept when >0)
+  const int *seedDist; // Only count subgraphs with a node at distance 0 (NULL: all)
+                       // (distance of each node to them, see GraphUtils::seedDistances)
+  void (*progress)(int next, GTrie *gt); // Called after each root (NULL: not)
+} CensusOptions;
+
+// State of one census (each census has its own)
+typedef struct {
+  int *mymap;          // Graph node matched at each depth
+  bool *used;          // Is graph node already matched?
+  bool **adjM;
+  int **fastnei;
+  int *numnei;
+  int **candbuf;       // Intersected candidates of each depth
+  int numNodes;
+  bool isdir;
+  bool intersect;
+  double *prob;        // Sampling probabilities of each depth
+  FILE *occ;
+  OccIndex *index;
+  const int *labels;
+  const string *names;
+  const int *seedDist;
+  int *near;           // Smallest seed distance of the nodes matched up to each depth
+  int size;            // Subgraph size
+} CensusState;
+
+// Line buffer of the ASCII g-trie reader (grows as needed)
+typedef struct {
+  char *buf;
+  int size;
+} LineBuffer;
+
+// Lists of g-trie nodes live on the arena of their g-trie
+typedef list<int,   ArenaAllocator<int> >           IntList;
+typedef list<iPair, ArenaAllocator<iPair> >         PairList;
+typedef list<IntList,  ArenaAllocator<IntList> >    IntListList;
+typedef list<PairList, ArenaAllocator<PairList> >   CondList;
+typedef list<GTrieNode *, ArenaAllocator<GTrieNode *> > ChildList;
+
+// Children indexed by their edges to the ancestors (out and in bitmasks)
+typedef pair<unsigned long long, unsigned long long> PatternKey;
+struct PatternHash {
+  size_t operator()(const PatternKey &k) const {
+    return (k.first*0x9E3779B97F4A7C15ULL) ^ (k.second + (k.second<<6) + (k.second>>2));
+  }
+};
+typedef unordered_map<PatternKey, GTrieNode *, PatternHash, equal_to<PatternKey>,
+		      ArenaAllocator<pair<const PatternKey, GTrieNode *> > > ChildIndex;
 
 class GTrieNode {
  private:
-  bool _is_intset_included(list<int> a, list<int> b);
-  bool _is_pairset_included(list<iPair> a, list<iPair> b);
+  Arena *_arena;      // Where this node and its lists are allocated
+  ChildIndex *_index; // Hashed children (NULL while they are few)
+
+  bool _is_intset_included(const IntList &a, const IntList &b);
+  bool _is_pairset_included(const PairList &a, const PairList &b);
+  GTrieNode *_newChild();
+  GTrieNode *_findChild(Graph *g);
+  GTrieNode *_addChild(Graph *g);
+  PatternKey _pattern();
+  int  _candidates(CensusState *st, int mylim, int **first, int *who);
+  int  _intersectCandidates(CensusState *st, int mylim, int **first, int ncand, int who);
+  void _writeOccurrence(CensusState *st);
 
  public:
 
-  static int *mymap;
-  static bool *used;
-  static bool **adjM;
-  static int **fastnei;
-  static int *numnei;
-  static int glk;
-  static int numNodes;
-  static bool isdir;
-  static double *prob;
-
-
-  list< list<int> >   this_node_cond; // This node must be bigger than all these nodes
-  list< list<iPair> > cond;           // List of symmetry breaking conditions
-  list<GTrieNode *> child;            // List of child g-trie nodes
+  IntListList this_node_cond;         // This node must be bigger than all these nodes
+  CondList    cond;                   // List of symmetry breaking conditions
+  ChildList   child;                  // List of child g-trie nodes
 
   bool cond_ok;                       // no need to check for conditions
   bool cond_this_ok;                  // no need to check for this node conditions
@@ -69,8 +158,7 @@ class GTrieNode {
   int *conn;          // Connected nodes
 
 
-  GTrieNode(int d);   // Create g-trie node with depth 'd'
-  ~GTrieNode();
+  GTrieNode(int d, Arena *a); // Create g-trie node with depth 'd' (arrays taken from 'a')
 
   void insert(Graph *g);
   void insertCond(Graph *g, list<iPair> *cond);
@@ -86,9 +174,9 @@ class GTrieNode {
 
   int frequencyGraph(Graph *g);
 
-  void goCondDir();
-  void goCondUndir();
-  void goCondSample();
+  void goCondDir(CensusState *st);
+  void goCondUndir(CensusState *st);
+  void goCondSample(CensusState *st);
 
   void insertConditionsFiltered(list<iPair> *cond);
 
@@ -98,8 +186,14 @@ class GTrieNode {
   void populateGraphTree(GraphTree *tree, char *s, int size);
   void populateMap(mapStringInt *m, char *s, int size);
 
+  int  getFrequencies(int *v, int pos);
+  int  setFrequencies(int *v, int pos);
+
   void writeToFile(FILE *f);
-  void readFromFile(FILE *f);
+  void readFromFile(FILE *f, LineBuffer *l);
+  void writeToTable(GTrieFileNode *t, vector<int> &pool);
+  void readFromTable(const GTrieFileNode *t, int i, const int *pool, int npool,
+		     GTrieNode **nodes);
 
   void cleanConditions();
   void clean(int a, int b);
@@ -108,8 +202,13 @@ class GTrieNode {
 
 class GTrie {
  private:
+  Arena _arena;       // Holds all nodes (freed with the g-trie)
   GTrieNode *_root;
 
+  void _readBinary(char *s);
+  void _censusBegin(Graph *g, int size, bool intersect, CensusState *st);
+  void _censusEnd(int size, CensusState *st);
+
  public:
   GTrie();
   ~GTrie();
@@ -118,14 +217,19 @@ class GTrie {
   void insertGraphCond(Graph *g, list<iPair> *cond);
   void insertGraphString(int size, const char* s);
   void insertGraphNautyString(int size, const char* s, bool dir, int label);
+  void insertCanonical(int size, const char *larger, bool dir, list<iPair> *cond);
+  static void canonicalConditions(int size, const char *s, bool dir, int label,
+				  char *larger, list<iPair> *cond);
 
   int frequencyGraphString(int size, const char *s);
 
   void showAsText(FILE *f);
   double compressionRate();
+  size_t memory() {return _arena.reserved();}
   int maxDepth();
 
   void census(Graph *g);
+  void census(Graph *g, const CensusOptions *o);
   void censusSample(Graph *g, double *p);
 
   void showFrequency();
@@ -139,11 +243,17 @@ class GTrie {
   void cleanConditions();
 
   void writeToFile(char *s);
-  void readFromFile(char *s);
+  void writeBinary(char *s);
+  void readFromFile(char *s);     // ASCII or binary (see GTRIE_BIN_MAGIC)
+  static bool isBinary(char *s);
   void readSubgraphs(int size, bool dir, char *s);
+  void insertSubgraphs(int size, bool dir, vector<string> &v);
 
   void populateGraphTree(GraphTree *tree, int size);
   void populateMap(mapStringInt *m, int size);
+
+  void getFrequencies(int *v); // Copy frequencies (one per subgraph) to 'v'
+  void setFrequencies(int *v); // Set frequencies from 'v' (as given by getFrequencies)
 };
 
 
@@ -0,0 +1,134 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Generation of all connected subgraphs of a given size
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Generator.h"
+#include "Isomorphism.h"
+#include "Parallel.h"
+#include "Error.h"
+#include "GTrie.h"
+#include <set>
+
+// One level of the generation
+typedef struct {
+  vector<string> *parents; // Graphs with n nodes
+  vector<string> *graphs;  // Accepted graphs with n+1 nodes
+  int n;
+  bool dir;
+} GeneratorLevel;
+
+// Is 'v' a cut node of 's' (ignoring edge directions)?
+bool Generator::_isCut(const char *s, int size, int v) {
+  int i, j, nbfs, bfs[size];
+  bool seen[size];
+
+  for (i=0; i<size; i++) seen[i]=false;
+  seen[v] = true;
+  bfs[0] = (v==0) ? 1 : 0;
+  seen[bfs[0]] = true;
+  for (i=0, nbfs=1; i<nbfs; i++)
+    for (j=0; j<size; j++)
+      if (!seen[j] && (s[bfs[i]*size+j]=='1' || s[j*size+bfs[i]]=='1')) {
+	seen[j] = true;
+	bfs[nbfs++] = j;
+      }
+  return nbfs < size-1;
+}
+
+// Extend parents [first, last) with one node connected to them in every way
+void Generator::_work(int first, int last, FILE *out, void *arg) {
+  GeneratorLevel *level = (GeneratorLevel *)arg;
+  int i, j, k, c, v, n = level->n, size = n+1;
+  int choices = level->dir ? 4 : 2; // Directed: none, to, from or both
+  int clab[size], orb[size];
+  char s[size*size+1], canon[size*size+1];
+  long long mask, nmasks = 1;
+  std::set<string> children; // (nauty also defines a "set")
+
+  for (j=0; j<n; j++) nmasks *= choices;
+
+  for (i=first; i<last; i++) {
+    const char *p = (*level->parents)[i].c_str();
+    children.clear();
+    for (j=0; j<n; j++)
+      for (k=0; k<n; k++)
+	s[j*size+k] = p[j*n+k];
+    s[n*size+n] = '0';
+    s[size*size] = 0;
+
+    for (mask=1; mask<nmasks; mask++) {
+      for (j=0, c=mask; j<n; j++, c/=choices) {
+	s[n*size+j] = (c%choices)&1 ? '1' : '0';
+	s[j*size+n] = level->dir ? (((c%choices)&2) ? '1' : '0') : s[n*size+j];
+      }
+
+      Isomorphism::canonicalLabelling(s, size, level->dir, clab, orb, canon);
+
+      // Last node of the canonical labelling that can be removed
+      for (j=size-1; j>=0; j--)
+	if (!_isCut(s, size, clab[j])) break;
+      v = clab[j];
+
+      if (orb[n]==orb[v] && children.insert(canon).second) {
+	fwrite(canon, 1, size*size, out);
+      }
+    }
+  }
+}
+
+void Generator::_merge(FILE *in, void *arg) {
+  GeneratorLevel *level = (GeneratorLevel *)arg;
+  int size = level->n+1;
+  char s[size*size+1];
+
+  s[size*size] = 0;
+  while (fread(s, 1, size*size, in)==(size_t)(size*size))
+    level->graphs->push_back(s);
+}
+
+void Generator::connectedGraphs(int size, bool dir, vector<string> &v) {
+  vector<string> parents;
+  GeneratorLevel level;
+
+  v.clear();
+  v.push_back("0");
+  for (level.n=1; level.n<size; level.n++) {
+    parents.swap(v);
+    v.clear();
+    level.parents = &parents;
+    level.graphs  = &v;
+    level.dir     = dir;
+    Parallel::run(parents.size(), _work, _merge, &level);
+  }
+}
+
+// (the name carries the binary format version, so older caches are regenerated)
+void Generator::cacheFile(const char *cache_dir, int size, bool dir, char *s) {
+  sprintf(s, "%s/complete_%d_%s.v%d.gtb", cache_dir, size, dir ? "dir" : "undir", GTRIE_BIN_VERSION);
+}
+
+// $GTRIE_CACHE, or ~/.gtrieScanner (current directory if there is no home)
+void Generator::defaultCacheDir(char *s) {
+  const char *env = getenv(GENERATOR_CACHE_ENV);
+  const char *home = getenv("HOME");
+
+  if (env!=NULL && strlen(env)<MAX_BUF) strcpy(s, env);
+  else if (home!=NULL && strlen(home)+strlen(GENERATOR_CACHE_DIR)+2<MAX_BUF)
+    sprintf(s, "%s/%s", home, GENERATOR_CACHE_DIR);
+  else strcpy(s, ".");
+}
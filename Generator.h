@@ -0,0 +1,48 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Generation of all connected subgraphs of a given size
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _GENERATOR_
+#define _GENERATOR_
+
+#include "Common.h"
+
+#define GENERATOR_CACHE_ENV "GTRIE_CACHE"      // Environment variable with cache directory
+#define GENERATOR_CACHE_DIR ".gtrieScanner"    // Default cache directory (under $HOME)
+
+// All non-isomorphic connected graphs with 'size' nodes, generated by
+// canonical augmentation: a graph of size n+1 is accepted from a parent
+// of size n only if the added node is on the orbit of the last (in the
+// canonical labelling) node whose removal leaves the graph connected.
+// Each level is split over Parallel::jobs() processes
+class Generator {
+ private:
+  static bool _isCut(const char *s, int size, int v);
+  static void _work(int first, int last, FILE *out, void *arg);
+  static void _merge(FILE *in, void *arg);
+
+ public:
+  // Graphs as adjacency strings (size*size characters), in a fixed order
+  static void connectedGraphs(int size, bool dir, vector<string> &v);
+
+  // Name of the cached g-trie with all graphs of 'size' nodes
+  static void cacheFile(const char *cache_dir, int size, bool dir, char *s);
+  static void defaultCacheDir(char *s);
+};
+
+#endif
@@ -158,6 +158,7 @@ void GraphTreeNode::populateGTrie(GTrie *gt, int size, int pos, char *s) {
 }
 
 void GraphTreeNode::populateMap(mapStringInt *m, int size, int pos, char *s) {
+  if (pos == 0 && zero == NULL && one == NULL) return; // empty tree
   if (zero == NULL && one == NULL) {
     s[pos]=0;
     char s2[size*size+1];
@@ -12,36 +12,115 @@ Released under Artistic License 2.0
 ----------------------------------------------------
 Graph Utilities
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #include "GraphUtils.h"
 #include "Error.h"
 #include <stdio.h>
+#include <errno.h>
 #include <vector>
 
 int *GraphUtils::_degree;
 int **GraphUtils::_ds;
 int *GraphUtils::_neighbours;
 
+bool GraphUtils::isNumber(const char *s, int *v) {
+  char *end;
+
+  if (!((s[0]>='1' && s[0]<='9') || !strcmp(s, "0"))) return false; // sign, zeros, ...
+  errno = 0;
+  long long x = strtoll(s, &end, 10);
+  if (*end != 0 || errno == ERANGE || x > INT_MAX) return false;
+  *v = x;
+  return true;
+}
+
+// Identifier 's' of a node. Numbers (see isNumber) keep their value and
+// any other text gets its index on 'strings', so that different texts
+// are always different nodes
+void GraphUtils::_readToken(const char *s, NodeToken *t, map<string, int> &str, vector<string> &strings) {
+  int v = 0;
+
+  t->str = !isNumber(s, &v);
+  t->num = v;
+  if (t->str) {
+    map<string, int>::iterator ii = str.find(s);
+    if (ii == str.end()) {
+      ii = str.insert(make_pair(string(s), (int)strings.size())).first;
+      strings.push_back(s);
+    }
+    t->num = ii->second;
+  }
+}
+
+// Read the edges of 'f' on 'va' and 'vb' (0-based nodes) and the integer
+// third column on 'vc' (if given, skipped if only 'third'). Returns the
+// number of nodes ('names' as on readFileTxt)
+int GraphUtils::_readEdges(FILE *f, bool third, vector<int> *va, vector<int> *vb,
+			   vector<int> *vc, vector<string> *names) {
+  int i, n;
+  char a[MAX_BUF], b[MAX_BUF], c[MAX_BUF];
+  NodeToken t;
+  vector<NodeToken> tok;
+  vector<int> num;
+  vector<string> strings;
+  map<string, int> str;
+
+  while (fscanf(f, "%1023s %1023s", a, b)==2) {
+    if (third && fscanf(f, "%1023s", c)!=1) break;
+    _readToken(a, &t, str, strings); tok.push_back(t);
+    _readToken(b, &t, str, strings); tok.push_back(t);
+    if (vc != NULL) vc->push_back(atoi(c));
+  }
+
+  for (i=0; i<(int)tok.size(); i++)
+    if (!tok[i].str) num.push_back(tok[i].num);
+  sort(num.begin(), num.end());
+  num.erase(unique(num.begin(), num.end()), num.end());
+
+  va->resize(tok.size()/2);
+  vb->resize(tok.size()/2);
+  names->clear();
+
+  // Dense positive integers: nodes are as on the file
+  if (strings.empty() && (num.empty() ||
+			  (num[0]>=1 && num.back() <= REMAP_SPARSE*(long long)num.size()))) {
+    for (i=0; i<(int)tok.size(); i++)
+      (i%2 ? *vb : *va)[i/2] = tok[i].num-1;
+    return num.empty() ? 0 : num.back();
+  }
+
+  // Otherwise numbers first (in order), then other strings. Numbers
+  // are written back as they were read (see isNumber)
+  for (i=0; i<(int)tok.size(); i++)
+    (i%2 ? *vb : *va)[i/2] = tok[i].str ? num.size() + tok[i].num :
+      lower_bound(num.begin(), num.end(), tok[i].num) - num.begin();
+  n = num.size() + strings.size();
+  names->reserve(n);
+  for (i=0; i<(int)num.size(); i++) {
+    sprintf(a, "%d", num[i]);
+    names->push_back(a);
+  }
+  names->insert(names->end(), strings.begin(), strings.end());
+  return n;
+}
+
 void GraphUtils::readFileTxt(Graph *g, const char *s, bool dir, bool weight) {
+  vector<string> names;
+  readFileTxt(g, s, dir, weight, &names);
+}
+
+void GraphUtils::readFileTxt(Graph *g, const char *s, bool dir, bool weight, vector<string> *names) {
 
   FILE *f = fopen(s, "r");
   if (!f) Error::msg(NULL);
 
-  int i, a, b, c, size, max;
+  int i, size, max;
   vector<int> va, vb;
 
-  size = max = 0;
-  while (fscanf(f,"%d %d", &a, &b)==2) {
-    if (weight) i=fscanf(f,"%d", &c);
-    va.push_back(a);
-    vb.push_back(b);
-    if (a>max) max=a;
-    if (b>max) max=b;
-    size++;
-  }
-    
+  max = _readEdges(f, weight, &va, &vb, NULL, names);
+  size = va.size();
   fclose(f);
 
   if (dir) g->createGraph(max, DIRECTED);
@@ -49,19 +128,74 @@ void GraphUtils::readFileTxt(Graph *g, const char *s, bool dir, bool weight) {
 
   for (i=0; i<size; i++) {
     if (va[i]==vb[i]) {
-      fprintf(stderr, "Self-Loop on %d ignored\n", va[i]);
+      if (names->empty()) fprintf(stderr, "Self-Loop on %d ignored\n", va[i]+1);
+      else fprintf(stderr, "Self-Loop on %s ignored\n", (*names)[va[i]].c_str());
       continue; // discard self loops!
     }
-    if (g->hasEdge(va[i]-1, vb[i]-1))
-      fprintf(stderr,"Repeated connection! %d %d\n", va[i], vb[i]);
-    else 
-      g->addEdge(va[i]-1, vb[i]-1);
-    if (!dir) g->addEdge(vb[i]-1, va[i]-1);
+    if (g->hasEdge(va[i], vb[i])) {
+      if (names->empty()) fprintf(stderr,"Repeated connection! %d %d\n", va[i]+1, vb[i]+1);
+      else fprintf(stderr,"Repeated connection! %s %s\n", (*names)[va[i]].c_str(), (*names)[vb[i]].c_str());
+    } else 
+      g->addEdge(va[i], vb[i]);
+    if (!dir) g->addEdge(vb[i], va[i]);
   } 
   va.clear();
   vb.clear();
 }
 
+static bool _earlier(const TimedEdge &x, const TimedEdge &y) {
+  return x.t < y.t;
+}
+
+int GraphUtils::readTimedEdges(const char *s, vector<TimedEdge> *v, vector<string> *names) {
+  int i, n;
+  TimedEdge e;
+  vector<int> va, vb, vc;
+
+  FILE *f = fopen(s, "r");
+  if (!f) Error::msg(NULL);
+  n = _readEdges(f, true, &va, &vb, &vc, names);
+  fclose(f);
+
+  v->clear();
+  for (i=0; i<(int)va.size(); i++) {
+    if (va[i]==vb[i]) continue; // self loops are discarded
+    e.a = va[i];
+    e.b = vb[i];
+    e.t = vc[i];
+    v->push_back(e);
+  }
+
+  stable_sort(v->begin(), v->end(), _earlier);
+  return n;
+}
+
+void GraphUtils::seedDistances(Graph *g, const vector<int> &seeds, int max, int *dist) {
+  int i, j, v, *nei, num, nbfs, n = g->numNodes();
+  int *bfs = new int[n];
+
+  for (i=0; i<n; i++) dist[i] = max+1;
+  nbfs = 0;
+  for (i=0; i<(int)seeds.size(); i++)
+    if (dist[seeds[i]] != 0) {
+      dist[seeds[i]] = 0;
+      bfs[nbfs++] = seeds[i];
+    }
+
+  for (i=0; i<nbfs; i++) {
+    v = bfs[i];
+    if (dist[v] == max) break;
+    nei = g->arrayNeighbours(v);
+    num = g->numNeighbours(v);
+    for (j=0; j<num; j++)
+      if (dist[nei[j]] > max) {
+	dist[nei[j]] = dist[v]+1;
+	bfs[nbfs++] = nei[j];
+      }
+  }
+  delete[] bfs;
+}
+
 void GraphUtils::strToGraph(Graph *g, const char *s, int size, bool dir) {
   int i,j;
 
@@ -89,54 +223,191 @@ int GraphUtils::_compare_int_descending(const void *a, const void *b) {
 int GraphUtils::_compare_degree(const void *a, const void *b) {
   int n1 = *((int *)a);
   int n2 = *((int *)b);
+  int i;
 
   if (_neighbours[n1] < _neighbours[n2]) return -1;
   if (_neighbours[n1] > _neighbours[n2]) return +1;
 
-  return 0;  
-}
+  for (i=0; i<_neighbours[n1]; i++) {
+    if (_ds[n1][i] < _ds[n2][i]) return -1;
+    if (_ds[n1][i] > _ds[n2][i]) return +1;
+  }
 
+  return n1 - n2;
+}
 
 // Order graph by increasing degree, then by increasing neighbour degree sequence
 void GraphUtils::orderGraph(Graph *old, Graph *g) {
-  int i, j, aux;
-  int size= old->numNodes();
-  int degree[size];
-  int *ds[size];
-  int neighbours[size];
+  int size = old->numNodes();
+  int *o = new int[size];
+
+  orderNodes(old, DEGREE, o);
+  renumberGraph(old, g, o);
+
+  delete[] o;
+}
+
+void GraphUtils::orderNodes(Graph *g, OrderType t, int *o) {
+  int i, j;
+  int size = g->numNodes();
   vector<int> *v;
 
+  if (t == DEGENERACY) {_orderDegeneracy(g, o); return;}
+  if (t == BFS)        {_orderBFS(g, o, false); return;}
+  if (t == RCM) {
+    _orderBFS(g, o, true);
+    for (i=0, j=size-1; i<j; i++, j--) swap(o[i], o[j]);
+    return;
+  }
+
+  for (i=0; i<size; i++) o[i]=i;
+  if (t != DEGREE && t != DEGREE_DESC) return;
+
+  int *neighbours = new int[size];
+  int **ds = new int*[size];
+
   for (i=0; i<size; i++) {
-    degree[i] = old->nodeOutEdges(i) + old->nodeOutEdges(i);
-    neighbours[i] = old->numNeighbours(i);
-    ds[i] = new int[neighbours[i]];        
-    v = old->neighbours(i);
+    neighbours[i] = g->numNeighbours(i);
+    ds[i] = new int[neighbours[i]];
+    v = g->neighbours(i);
     for (j=0; j<neighbours[i]; j++)
-      ds[i][j] = old->nodeOutEdges((*v)[j]) + old->nodeOutEdges((*v)[j]);
-    qsort(ds[i], old->numNeighbours(i), sizeof(int), _compare_int);
+      ds[i][j] = g->numNeighbours((*v)[j]);
+    qsort(ds[i], neighbours[i], sizeof(int), _compare_int);
   }
-  
-  _degree =  degree;
-  _ds     = ds;
+
+  _ds         = ds;
   _neighbours = neighbours;
-  int n[size], r[size];
-  for (i=0; i<size; i++) n[i]=i;
-  qsort(n, size, sizeof(int), _compare_degree);
-  for (i=0; i<size; i++) r[n[i]]=i;
+  qsort(o, size, sizeof(int), _compare_degree);
+  if (t == DEGREE_DESC)
+    for (i=0, j=size-1; i<j; i++, j--) swap(o[i], o[j]);
 
   for (i=0; i<size; i++)
     delete[] ds[i];
+  delete[] ds;
+  delete[] neighbours;
+}
+
+// Degeneracy order: repeatedly remove a node of minimum remaining degree
+// (bucket queue, linear time)
+void GraphUtils::_orderDegeneracy(Graph *g, int *o) {
+  int i, j, u, w, x, du, pw, pu, maxd;
+  int size = g->numNodes();
+  vector<int> *v;
+
+  int *deg = new int[size];
+  int *pos = new int[size];
+  int *vert = new int[size];
+
+  maxd = 0;
+  for (i=0; i<size; i++) {
+    deg[i] = g->numNeighbours(i);
+    if (deg[i] > maxd) maxd = deg[i];
+  }
+
+  // bin[d] = position of first node with degree d on 'vert'
+  int *bin = new int[maxd+1];
+  for (i=0; i<=maxd; i++) bin[i] = 0;
+  for (i=0; i<size; i++) bin[deg[i]]++;
+  for (i=0, j=0; i<=maxd; i++) {w = bin[i]; bin[i] = j; j += w;}
+  for (i=0; i<size; i++) {
+    pos[i] = bin[deg[i]];
+    vert[pos[i]] = i;
+    bin[deg[i]]++;
+  }
+  for (i=maxd; i>0; i--) bin[i] = bin[i-1];
+  bin[0] = 0;
+
+  for (i=0; i<size; i++) {
+    u = vert[i];
+    o[i] = u;
+    v = g->neighbours(u);
+    for (j=0; j<(int)v->size(); j++) {
+      w = (*v)[j];
+      if (deg[w] > deg[u]) {
+        du = deg[w]; pw = pos[w];
+        pu = bin[du]; x = vert[pu];
+        if (x != w) {
+          pos[w] = pu; vert[pu] = w;
+          pos[x] = pw; vert[pw] = x;
+        }
+        bin[du]++;
+        deg[w]--;
+      }
+    }
+  }
+
+  delete[] deg;
+  delete[] pos;
+  delete[] vert;
+  delete[] bin;
+}
+
+// Breadth-first order of every component, starting at the node of highest
+// degree. With 'cuthill', start at the node of lowest degree and visit
+// neighbours by increasing degree (Cuthill-McKee)
+void GraphUtils::_orderBFS(Graph *g, int *o, bool cuthill) {
+  int i, j, k, s, head, tail;
+  int size = g->numNodes();
+  vector<int> *v;
+  vector<int> nei;
+
+  int *start = new int[size];
+  bool *seen = new bool[size];
+  for (i=0; i<size; i++) {start[i] = i; seen[i] = false;}
+
+  // Candidate start nodes, best first
+  _neighbours = new int[size];
+  for (i=0; i<size; i++) _neighbours[i] = g->numNeighbours(i);
+  stable_sort(start, start+size, cuthill ? _less_degree : _greater_degree);
+
+  head = tail = 0;
+  for (s=0; s<size; s++) {
+    if (seen[start[s]]) continue;
+    seen[start[s]] = true;
+    o[tail++] = start[s];
+    while (head < tail) {
+      i = o[head++];
+      v = g->neighbours(i);
+      nei.clear();
+      for (j=0; j<(int)v->size(); j++)
+        if (!seen[(*v)[j]]) {
+          seen[(*v)[j]] = true;
+          nei.push_back((*v)[j]);
+        }
+      if (cuthill) stable_sort(nei.begin(), nei.end(), _less_degree);
+      for (k=0; k<(int)nei.size(); k++)
+        o[tail++] = nei[k];
+    }
+  }
+
+  delete[] _neighbours;
+  delete[] start;
+  delete[] seen;
+}
+
+bool GraphUtils::_less_degree(int a, int b) {
+  return _neighbours[a] < _neighbours[b];
+}
+
+bool GraphUtils::_greater_degree(int a, int b) {
+  return _neighbours[a] > _neighbours[b];
+}
+
+void GraphUtils::renumberGraph(Graph *old, Graph *g, int *o) {
+  int i, j, aux;
+  int size = old->numNodes();
+  int *r = new int[size];
+  vector<int> *v;
+
+  for (i=0; i<size; i++) r[o[i]] = i;
 
   g->createGraph(size, old->type());
   for (i=0; i<size; i++) {
-    v = old->outEdges(i);
+    v = old->outEdges(o[i]);
     aux = v->size();
     for (j=0; j<aux; j++)
-      g->addEdge(r[i], r[(*v)[j]]);
-    v = old->inEdges(i);
-    aux = v->size();
-    for (j=0; j<aux; j++)
-      g->addEdge(r[(*v)[j]], r[i]);
+      g->addEdge(i, r[(*v)[j]]);
   }
-  
+
+  delete[] r;
 }
@@ -12,7 +12,7 @@ Released under Artistic License 2.0
 ----------------------------------------------------
 Graph Utilities
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #ifndef _GRAPHUTILS_
@@ -20,27 +20,76 @@ Last Update: 11/02/2012
 
 #include "Graph.h"
 
+#define REMAP_SPARSE 2 // Renumber integer nodes if the largest is above this times their number
+
+// Node identifier as read (number or any other string, see GraphUtils::isNumber)
+typedef struct {
+  int num;             // Value (numbers) or index on the strings read
+  bool str;
+} NodeToken;
+
+// Edge a-b at time t (nodes numbered from 0)
+typedef struct {
+  int a, b, t;
+} TimedEdge;
+
 class GraphUtils {
  private:
   static int *_degree;
   static int **_ds;
   static int *_neighbours;
+
+  static int  _readEdges(FILE *f, bool third, vector<int> *va, vector<int> *vb,
+			 vector<int> *vc, vector<string> *names);
+  static void _readToken(const char *s, NodeToken *t, map<string, int> &str, vector<string> &strings);
+  static void _orderDegeneracy(Graph *g, int *o);
+  static void _orderBFS(Graph *g, int *o, bool cuthill);
   
  public:
 
   // Compare two integers
   static int int_compare(const void *a, const void *b);
 
-  // Read file 's', with direction 'dir' to graph 'g'
+  // Is node identifier 's' a number, written as printf would (no sign nor
+  // leading zeros, up to INT_MAX)? Its value goes to 'v'. Other identifiers
+  // (e.g. "007" or larger ids) are told apart by their text
+  static bool isNumber(const char *s, int *v);
+
+  // Read file 's', with direction 'dir' to graph 'g'.
+  // Nodes are numbered as on the file (from 1), unless they are not all
+  // positive numbers (see isNumber), or these are sparse: then they are
+  // numbered densely (numbers in increasing order, then other strings as
+  // they appear)
+  // and 'names' gets the identifier of each node (it is left empty if not)
   static void readFileTxt(Graph *g, const char *s, bool dir, bool weight);
+  static void readFileTxt(Graph *g, const char *s, bool dir, bool weight, vector<string> *names);
+
+  // Read edges of file 's' with the third column as their time
+  // (sorted by time, self loops discarded, nodes as on readFileTxt).
+  // Returns the number of nodes
+  static int readTimedEdges(const char *s, vector<TimedEdge> *v, vector<string> *names);
+
+  // Distance of each node of 'g' to the nearest of 'seeds', ignoring edge
+  // direction ('max'+1 if farther than 'max'). Needs the neighbour arrays
+  static void seedDistances(Graph *g, const vector<int> &seeds, int max, int *dist);
 
   // Convert adjacency matrix to graph of 'size' nodes
   static void strToGraph(Graph *g, const char *s, int size, bool dir);
 
+  // Order graph by increasing degree, then by increasing neighbour degree sequence
   static void orderGraph(Graph *old, Graph *g);
+
+  // Compute ordering 'o' of nodes of 'g' (o[i] is the node placed at position i)
+  static void orderNodes(Graph *g, OrderType t, int *o);
+
+  // Create in 'g' a copy of 'old' with node o[i] renumbered as i
+  static void renumberGraph(Graph *old, Graph *g, int *o);
+
   static int _compare_int(const void *a, const void *b);
   static int _compare_int_descending(const void *a, const void *b);
   static int _compare_degree(const void *a, const void *b);
+  static bool _less_degree(int a, int b);
+  static bool _greater_degree(int a, int b);
   
 };
 
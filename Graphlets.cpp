@@ -0,0 +1,290 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Undirected subgraphs of size 4 from equations
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Graphlets.h"
+#include "Isomorphism.h"
+#include "Parallel.h"
+#include "Generator.h"
+#include "SetOps.h"
+#include "Error.h"
+
+map<string, string> Graphlets::_class;
+
+// Each subgraph (as an adjacency string) and the orbit used to count it,
+// which has 'nodes' of its nodes
+static const struct {
+  const char *s;
+  int orbit, nodes;
+} _graphs[GRAPHLET_CLASSES] = {
+  {"0100101001010010",  1, 2}, // path 0-1-2-3
+  {"0111100010001000",  3, 1}, // star (centre 0)
+  {"0101101001011010",  4, 4}, // cycle 0-1-2-3
+  {"0111101011001000",  7, 1}, // tailed triangle 0-1-2 (tail on 0)
+  {"0111100110011110",  9, 2}, // diamond (no edge 1-2)
+  {"0111101111011110", 10, 4}  // clique
+};
+
+static const struct {
+  const char *name;
+  int graph;
+} _orbits[GRAPHLET_ORBITS] = {
+  {"path, end", 0},               {"path, middle", 0},
+  {"star, leaf", 1},              {"star, centre", 1},
+  {"cycle", 2},
+  {"tailed triangle, tail", 3},   {"tailed triangle, other", 3},
+  {"tailed triangle, centre", 3},
+  {"diamond, degree 2", 4},       {"diamond, degree 3", 4},
+  {"clique", 5}
+};
+
+// State of a census (shared by its processes, see Graphlets::census)
+typedef struct {
+  Graph *g;
+  int *first;          // First neighbour of each node on 'common'
+  int *common;         // Common neighbours of each node and each of its neighbours
+  long long *tri;      // Triangles on each node
+  long long *sum;      // Sum of the degrees (minus one) of the neighbours of each node
+  long long *orbits;
+} GraphletsJob;
+
+// Number of elements larger than 'v' on sorted 'a' (and where they start)
+static int _above(int *a, int n, int v, int **start) {
+  int i = upper_bound(a, a+n, v) - a;
+  *start = a+i;
+  return n-i;
+}
+
+// Common neighbours of each node of [first, last) and its larger neighbours
+void Graphlets::_commonWork(int first, int last, FILE *out, void *arg) {
+  Graph *g = ((GraphletsJob *)arg)->g;
+  int i, c, n, m, x, *nx, *ny, *buf;
+  int maxdeg = 0;
+
+  for (x=first; x<last; x++) maxdeg = max(maxdeg, g->numNeighbours(x));
+  buf = new int[maxdeg+1];
+
+  fwrite(&first, sizeof(int), 1, out);
+  fwrite(&last, sizeof(int), 1, out);
+  for (x=first; x<last; x++) {
+    nx = g->arrayNeighbours(x);
+    n  = g->numNeighbours(x);
+    for (i=0; i<n; i++) {
+      if (nx[i] < x) continue;
+      ny = g->arrayNeighbours(nx[i]);
+      m  = g->numNeighbours(nx[i]);
+      c  = SetOps::intersect(nx, n, ny, m, buf);
+      fwrite(&c, sizeof(int), 1, out);
+    }
+  }
+  delete[] buf;
+}
+
+void Graphlets::_commonMerge(FILE *in, void *arg) {
+  GraphletsJob *job = (GraphletsJob *)arg;
+  Graph *g = job->g;
+  int i, j, c, n, x, y, first, last, *nx, *ny;
+
+  if (fread(&first, sizeof(int), 1, in)!=1 || fread(&last, sizeof(int), 1, in)!=1)
+    Error::msg("Incomplete graphlet census results");
+  for (x=first; x<last; x++) {
+    nx = g->arrayNeighbours(x);
+    n  = g->numNeighbours(x);
+    for (i=0; i<n; i++) {
+      y = nx[i];
+      if (y < x) continue;
+      if (fread(&c, sizeof(int), 1, in)!=1)
+	Error::msg("Incomplete graphlet census results");
+      ny = g->arrayNeighbours(y);
+      j  = lower_bound(ny, ny+g->numNeighbours(y), x) - ny;
+      job->common[job->first[x]+i] = job->common[job->first[y]+j] = c;
+    }
+  }
+}
+
+// Orbits of the nodes [first, last). Counts of each orbit as a
+// subgraph (nc) are turned into induced counts (o), larger first.
+// Orbit numbers are those of Graphlets::orbitName
+void Graphlets::_orbitWork(int first, int last, FILE *out, void *arg) {
+  GraphletsJob *job = (GraphletsJob *)arg;
+  Graph *g = job->g;
+  int i, j, k, c, d, n, x, y, z, w, nn, *nx, *ny, *nz, *cxy, *above, *wedges, *buf;
+  long long nc[GRAPHLET_ORBITS], o[GRAPHLET_ORBITS], t, cyz, dy;
+  int maxdeg = 0;
+
+  for (x=first; x<last; x++) maxdeg = max(maxdeg, g->numNeighbours(x));
+  cxy    = new int[maxdeg+1];
+  buf    = new int[maxdeg+1];
+  wedges = new int[g->numNodes()];
+  for (x=0; x<g->numNodes(); x++) wedges[x] = 0;
+
+  fwrite(&first, sizeof(int), 1, out);
+  fwrite(&last, sizeof(int), 1, out);
+  for (x=first; x<last; x++) {
+    nx = g->arrayNeighbours(x);
+    d  = g->numNeighbours(x);
+    t  = job->tri[x];
+    memset(nc, 0, sizeof(nc));
+
+    nc[3] = (long long)d*(d-1)*(d-2)/6;                   // star, centre
+    nc[7] = t*(d-2);                                      // tailed triangle, centre
+    nc[1] = (d-1)*job->sum[x] - 2*t;                      // path, middle
+    nc[0] = -(long long)d*(d-1) - 2*t;                    // path, end
+    for (i=0; i<d; i++) {
+      y  = nx[i];
+      dy = g->numNeighbours(y);
+      c  = job->common[job->first[x]+i];
+      nc[0] += job->sum[y];
+      nc[2] += (dy-1)*(dy-2)/2;                           // star, leaf
+      nc[5] += job->tri[y] - c;                           // tailed triangle, tail
+      nc[9] += (long long)c*(c-1)/2;                      // diamond, degree 3
+
+      // Triangles x, y, z (y < z) and cliques x, y, z, w (y < z < w)
+      ny = g->arrayNeighbours(y);
+      n  = SetOps::intersect(nx, d, ny, dy, cxy);
+      for (j=0; j<n; j++) {
+	z = cxy[j];
+	if (z < y) continue;
+	k   = lower_bound(ny, ny+dy, z) - ny;
+	cyz = job->common[job->first[y]+k];
+	nc[8] += cyz-1;                                   // diamond, degree 2
+	nc[6] += dy + g->numNeighbours(z) - 4;            // tailed triangle, other
+	nz = g->arrayNeighbours(z);
+	nn = _above(nz, g->numNeighbours(z), z, &above);
+	nc[10] += SetOps::intersect(cxy+j+1, n-j-1, above, nn, buf);
+      }
+
+      // Nodes at distance two through y (cycles)
+      for (j=0; j<dy; j++)
+	if (ny[j] != x) wedges[ny[j]]++;
+    }
+    for (i=0; i<d; i++) {
+      ny = g->arrayNeighbours(nx[i]);
+      dy = g->numNeighbours(nx[i]);
+      for (j=0; j<dy; j++) {
+	w = ny[j];
+	nc[4] += (long long)wedges[w]*(wedges[w]-1)/2;   // cycle
+	wedges[w] = 0;
+      }
+    }
+
+    // Induced counts (each line: orbits of larger subgraphs containing this one)
+    o[10] = nc[10];
+    o[9]  = nc[9] - 3*o[10];
+    o[8]  = nc[8] - 3*o[10];
+    o[4]  = nc[4] - o[9] - o[8] - 3*o[10];
+    o[7]  = nc[7] - 2*o[9] - 3*o[10];
+    o[6]  = nc[6] - 2*o[9] - 2*o[8] - 6*o[10];
+    o[5]  = nc[5] - 2*o[8] - 3*o[10];
+    o[3]  = nc[3] - o[7] - o[9] - o[10];
+    o[2]  = nc[2] - o[5] - o[6] - o[9] - 2*o[8] - 3*o[10];
+    o[1]  = nc[1] - 2*o[7] - o[6] - 2*o[4] - 4*o[9] - 2*o[8] - 6*o[10];
+    o[0]  = nc[0] - 2*o[5] - o[6] - 2*o[4] - 2*o[9] - 4*o[8] - 6*o[10];
+    fwrite(o, sizeof(long long), GRAPHLET_ORBITS, out);
+  }
+  delete[] cxy;
+  delete[] buf;
+  delete[] wedges;
+}
+
+void Graphlets::_orbitMerge(FILE *in, void *arg) {
+  GraphletsJob *job = (GraphletsJob *)arg;
+  int first, last;
+
+  if (fread(&first, sizeof(int), 1, in)!=1 || fread(&last, sizeof(int), 1, in)!=1 ||
+      fread(job->orbits + (long long)first*GRAPHLET_ORBITS, sizeof(long long),
+	    (size_t)(last-first)*GRAPHLET_ORBITS, in)!=(size_t)(last-first)*GRAPHLET_ORBITS)
+    Error::msg("Incomplete graphlet census results");
+}
+
+void Graphlets::census(Graph *g, long long *orbits) {
+  int i, j, nodes = g->numNodes(), *nx;
+  GraphletsJob job;
+
+  job.g      = g;
+  job.orbits = orbits;
+  job.first  = new int[nodes+1];
+  job.tri    = new long long[nodes];
+  job.sum    = new long long[nodes];
+  job.first[0] = 0;
+  for (i=0; i<nodes; i++) {
+    nx = g->arrayNeighbours(i);
+    job.first[i+1] = job.first[i] + g->numNeighbours(i);
+    job.sum[i] = 0;
+    for (j=0; j<g->numNeighbours(i); j++)
+      job.sum[i] += g->numNeighbours(nx[j]) - 1;
+  }
+  job.common = new int[job.first[nodes]];
+
+  Parallel::run(nodes, _commonWork, _commonMerge, &job);
+  for (i=0; i<nodes; i++) {
+    job.tri[i] = 0;
+    for (j=job.first[i]; j<job.first[i+1]; j++) job.tri[i] += job.common[j];
+    job.tri[i] /= 2;
+  }
+  Parallel::run(nodes, _orbitWork, _orbitMerge, &job);
+
+  delete[] job.first;
+  delete[] job.common;
+  delete[] job.tri;
+  delete[] job.sum;
+}
+
+// Class strings are those of a g-trie with all the subgraphs
+// (see GTrie::insertSubgraphs), indexed by their nauty canonical form
+void Graphlets::_classes() {
+  int i;
+  vector<string> v;
+  char canon[17], larger[17];
+
+  if (!_class.empty()) return;
+  Generator::connectedGraphs(4, false, v);
+  for (i=0; i<(int)v.size(); i++) {
+    Isomorphism::canonicalNauty(v[i].c_str(), canon, 4);
+    Isomorphism::canonicalBasedNauty(v[i].c_str(), larger, 4);
+    _class[canon] = larger;
+  }
+}
+
+void Graphlets::populateGraphTree(const long long *orbits, int nodes, GraphTree *sg) {
+  int i, x;
+  long long f;
+  char s[17];
+
+  for (i=0; i<GRAPHLET_CLASSES; i++) {
+    for (f=0, x=0; x<nodes; x++)
+      f += orbits[(long long)x*GRAPHLET_ORBITS + _graphs[i].orbit];
+    orbitClass(_graphs[i].orbit, s); // Absent classes too, as in a complete g-trie
+    f /= _graphs[i].nodes;
+    if (f > INT_MAX) // (results keep int frequencies)
+      Error::msg("Frequency of subgraph %s (%lld) is larger than %d", s, f, INT_MAX);
+    sg->setString(s, f);
+  }
+}
+
+const char *Graphlets::orbitName(int i) {
+  return _orbits[i].name;
+}
+
+void Graphlets::orbitClass(int i, char *s) {
+  char canon[17];
+
+  _classes();
+  Isomorphism::canonicalNauty(_graphs[_orbits[i].graph].s, canon, 4);
+  strcpy(s, _class[canon].c_str());
+}
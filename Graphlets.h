@@ -0,0 +1,61 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Undirected subgraphs of size 4 from equations
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _GRAPHLETS_
+#define _GRAPHLETS_
+
+#include "Common.h"
+#include "Graph.h"
+#include "GraphTree.h"
+
+#define GRAPHLET_CLASSES 6  // Connected undirected subgraphs of size 4
+#define GRAPHLET_ORBITS  11 // Roles of a node on them (see Graphlets::orbitName)
+
+// Frequencies of the connected undirected subgraphs of size 4, and the
+// number of them each node is on (by role, its orbit), without
+// enumerating them. For each node we count, from degrees and common
+// neighbours, how many times each orbit appears as a (not necessarily
+// induced) subgraph: a node on one orbit is also on the orbits of the
+// subgraphs its subgraph contains (e.g. a cycle has four paths), so
+// going from the clique down, each induced count is the non-induced one
+// minus what the larger subgraphs add. Only cliques are enumerated, and
+// cycles through the common neighbours of the nodes at distance two.
+// Nodes are split over Parallel::jobs() processes.
+class Graphlets {
+ private:
+  static map<string, string> _class; // Class of each canonical subgraph (see Triads)
+
+  static void _classes();
+  static void _commonWork(int first, int last, FILE *out, void *arg);
+  static void _commonMerge(FILE *in, void *arg);
+  static void _orbitWork(int first, int last, FILE *out, void *arg);
+  static void _orbitMerge(FILE *in, void *arg);
+
+ public:
+  // Orbits of each node of 'g' (GRAPHLET_ORBITS per node, node by node)
+  static void census(Graph *g, long long *orbits);
+
+  // Frequencies by class, with the strings of a g-trie (needs Isomorphism::initNauty)
+  static void populateGraphTree(const long long *orbits, int nodes, GraphTree *sg);
+
+  static const char *orbitName(int i);
+  static void orbitClass(int i, char *s); // Adjacency string of its subgraph (g-trie)
+};
+
+#endif
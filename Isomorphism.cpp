@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Isomorphism Utilities
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #include "Isomorphism.h"
@@ -33,6 +33,8 @@ int Isomorphism::orbits[MAXN];
 bool Isomorphism::dir;
 
 DEFAULTOPTIONS(options);
+DEFAULTOPTIONS(autoptions); // Only orbits, with a given partition (see automorphismOrbits)
+DEFAULTOPTIONS(canonoptions); // Canonical labelling of any size (see canonicalLabelling)
 statsblk(stats);
 graph mm[MAXN*MAXM];
 
@@ -50,6 +52,67 @@ void Isomorphism::initNauty(int size, bool directed) {
   else     options.digraph = FALSE;
 }
 
+// Orbits of the automorphisms of 'myg' that fix nodes 0..fixed-1
+// (node i is on the same orbit as orb[i])
+void Isomorphism::automorphismOrbits(Graph *myg, int fixed, int *orb) {
+  int i, j, size = myg->numNodes();
+  int sm = (size + WORDSIZE - 1) / WORDSIZE;
+  boolean digraph = FALSE;
+
+  // (the type of subgraphs built by GraphUtils::strToGraph is not reliable)
+  for (i=0; i<size; i++) {
+    gv = GRAPHROW(g,i,sm);
+    EMPTYSET(gv,sm);
+    for (j=0; j<size; j++) {
+      if (myg->hasEdge(i,j)) ADDELEMENT(gv,j);
+      if (myg->hasEdge(i,j) != myg->hasEdge(j,i)) digraph = TRUE;
+    }
+  }
+
+  // Fixed nodes are cells of their own, the other nodes share one cell
+  for (i=0; i<size; i++) {
+    lab[i] = i;
+    ptn[i] = (i<fixed || i==size-1) ? 0 : 1;
+  }
+
+  autoptions.getcanon   = FALSE;
+  autoptions.defaultptn = FALSE;
+  autoptions.digraph    = digraph;
+
+  nauty(g,lab,ptn,NULL,orb,&autoptions,&stats,
+	workspace,WORKSPACE_SIZE,sm,size,NULL);
+}
+
+// Canonical labelling of 'in' (vertex clab[i] of 'in' is vertex i of 'canon')
+// and orbits of its automorphisms. Unlike canonicalBasedNauty, this is a true
+// canonical form: isomorphic graphs always give the same 'canon'
+void Isomorphism::canonicalLabelling(const char *in, int size, bool directed,
+				     int *clab, int *orb, char *canon) {
+  int i, j, aux;
+  int sm = (size + WORDSIZE - 1) / WORDSIZE;
+
+  for (i=0; i<size; i++) {
+    gv = GRAPHROW(g,i,sm);
+    EMPTYSET(gv,sm);
+    for (j=0; j<size; j++)
+      if (in[i*size+j]=='1') ADDELEMENT(gv,j);
+  }
+
+  canonoptions.getcanon = TRUE;
+  canonoptions.digraph  = directed ? TRUE : FALSE;
+
+  nauty(g,clab,ptn,NULL,orb,&canonoptions,&stats,
+	workspace,WORKSPACE_SIZE,sm,size,mm);
+
+  aux=0;
+  for (i=0; i<size; i++) {
+    gv = GRAPHROW(mm,i,sm); 
+    for (j=0; j<size; j++)
+      canon[aux++] = ISELEMENT(gv,j)?'1':'0';
+  }
+  canon[aux]=0;
+}
+
 void Isomorphism::finishNauty() {
   nauty_freedyn();
   naugraph_freedyn();
@@ -60,7 +123,7 @@ void Isomorphism::finishNauty() {
 void Isomorphism::canonicalStrNauty(Graph *myg, int *v, char *s) {
   int i, j, aux;
 
-  static bool **adjM = myg->adjacencyMatrix();
+  bool **adjM = myg->adjacencyMatrix();
 
   for (i=0; i<n; i++) {
     gv = GRAPHROW(g,i,m);
@@ -47,6 +47,9 @@ class Isomorphism {
   static void finishNauty();
 
   static void canonicalStrNauty(Graph *g, int *v, char *s);
+  static void automorphismOrbits(Graph *g, int fixed, int *orb);
+  static void canonicalLabelling(const char *in, int size, bool dir,
+				 int *clab, int *orb, char *canon);
 
   static void canonicalNauty(const char *in, char *out, int size);
   static void canonicalBigger(const char *in, char *out, int size);
@@ -0,0 +1,459 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Index of the occurrences of each subgraph
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "OccIndex.h"
+#include "Error.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Bytes of 'v' as a varint
+static int _varintSize(unsigned long long v) {
+  int n = 1;
+  while (v >= 128) {v >>= 7; n++;}
+  return n;
+}
+
+static unsigned char *_putVarint(unsigned char *p, unsigned long long v) {
+  while (v >= 128) {
+    *p++ = (v & 127) | 128;
+    v >>= 7;
+  }
+  *p++ = v;
+  return p;
+}
+
+// Read a varint that must end before 'end' (NULL if it does not)
+static const unsigned char *_getVarint(const unsigned char *p, const unsigned char *end,
+				       unsigned long long *v) {
+  int shift = 0;
+  *v = 0;
+  do {
+    if (p>=end || shift>63) return NULL;
+    *v |= (unsigned long long)(*p & 127) << shift;
+    shift += 7;
+  } while (*p++ & 128);
+  return p;
+}
+
+// Write 'n' items of 'size' bytes, exiting on failure
+static void _write(const void *p, size_t size, size_t n, FILE *f) {
+  if (fwrite(p, size, n, f) != n) Error::msg(NULL);
+}
+
+OccIndex::OccIndex(const char *s, int size) {
+  strcpy(_file, s);
+  sprintf(_spill_file, "%s.tmp", s);
+  _spill = fopen(_spill_file, "w+b");
+  if (_spill==NULL) Error::msg("Unable to open occurrence index file \"%s\"", _spill_file);
+  _size = size;
+  _max_node = -1;
+  _rec = new int[size+1];
+}
+
+OccIndex::~OccIndex() {
+  if (_spill!=NULL) { // never closed
+    fclose(_spill);
+    remove(_spill_file);
+  }
+  delete[] _rec;
+}
+
+void OccIndex::add(const char *adj, const int *labels) {
+  int i, c;
+
+  _key.assign(adj, _size*_size);
+  unordered_map<string, int>::iterator ii = _id.find(_key);
+  if (ii == _id.end()) {
+    c = _classes.size();
+    _id[_key] = c;
+    _classes.push_back(_key);
+    _count.push_back(0);
+  } else c = ii->second;
+  _count[c]++;
+
+  _rec[0] = c;
+  for (i=0; i<_size; i++) {
+    _rec[i+1] = labels[i];
+    if (labels[i] > _max_node) _max_node = labels[i];
+  }
+  _write(_rec, sizeof(int), _size+1, _spill);
+}
+
+long long OccIndex::occurrences() {
+  long long n = 0;
+  for (int i=0; i<(int)_count.size(); i++) n += _count[i];
+  return n;
+}
+
+// Move the occurrences of the spill file to the run of their class,
+// a chunk at a time ('rank': position of each class on 'table')
+void OccIndex::_group(FILE *f, OccIndexClass *table, const int *rank) {
+  int i, c, n, nc = _classes.size();
+  int *rec = new int[OCCINDEX_CHUNK*(_size+1)];
+  int *run = new int[OCCINDEX_CHUNK*_size];
+  vector<long long> cursor(nc);
+  vector<int> cnt(nc), start(nc+1);
+
+  for (c=0; c<nc; c++) cursor[c] = table[c].occ;
+  fflush(_spill);
+  rewind(_spill);
+  while ((n = fread(rec, sizeof(int)*(_size+1), OCCINDEX_CHUNK, _spill)) > 0) {
+    fill(cnt.begin(), cnt.end(), 0);
+    for (i=0; i<n; i++) cnt[rank[rec[i*(_size+1)]]]++;
+    for (c=0, start[0]=0; c<nc; c++) start[c+1] = start[c]+cnt[c];
+    for (i=0; i<n; i++) {
+      c = rank[rec[i*(_size+1)]];
+      memcpy(run + (start[c]++)*_size, rec + i*(_size+1) + 1, sizeof(int)*_size);
+    }
+    for (c=0; c<nc; c++)
+      if (cnt[c]>0) {
+	fseeko(f, cursor[c], SEEK_SET);
+	_write(run + (start[c]-cnt[c])*_size, sizeof(int), cnt[c]*_size, f);
+	cursor[c] += (long long)cnt[c]*_size*sizeof(int);
+      }
+  }
+  delete[] rec;
+  delete[] run;
+}
+
+// Write the node directory and postings of class 'c' at 'pos' (moved to
+// their end). Its occurrences are read twice: first to know the size of
+// the postings of each node, then to write them
+void OccIndex::_postings(FILE *f, OccIndexClass *c, long long *pos) {
+  int i, j, v, n, pass;
+  long long o, total, base, dir_pos;
+  unsigned char *post = NULL;
+  int *buf = new int[OCCINDEX_CHUNK*_size];
+  vector<int> touched;
+  vector<OccIndexNode> dir;
+
+  for (pass=0; pass<2; pass++) {
+    for (o=0; o<c->count; o+=n) {
+      n = min((long long)OCCINDEX_CHUNK, c->count-o);
+      fseeko(f, c->occ + o*_size*sizeof(int), SEEK_SET);
+      if (fread(buf, sizeof(int), n*_size, f) != (size_t)n*_size) Error::msg(NULL);
+      for (i=0; i<n; i++)
+	for (j=0; j<_size; j++) {
+	  v = buf[i*_size+j];
+	  if (pass==0) {
+	    if (_nocc[v]++ == 0) touched.push_back(v);
+	    _bytes[v] += _varintSize(o+i-_last[v]);
+	  } else
+	    _bytes[v] = _putVarint(post+_bytes[v], o+i-_last[v]) - post;
+	  _last[v] = o+i;
+	}
+    }
+    if (pass==1) break;
+
+    // Directory, with the postings after it (the offset of
+    // each node on 'post' is kept on _bytes while writing)
+    sort(touched.begin(), touched.end());
+    dir.resize(touched.size());
+    dir_pos = (*pos+7) & ~7LL;
+    base = dir_pos + dir.size()*sizeof(OccIndexNode);
+    for (i=0, total=0; i<(int)touched.size(); i++) {
+      v = touched[i];
+      dir[i].node     = v;
+      dir[i].pad      = 0;
+      dir[i].count    = _nocc[v];
+      dir[i].postings = base+total;
+      total += _bytes[v];
+      _bytes[v] = total-_bytes[v];
+      _last[v]  = -1;
+    }
+    post = new unsigned char[total>0 ? total : 1];
+  }
+
+  c->dir    = dir_pos;
+  c->nnodes = dir.size();
+  fseeko(f, dir_pos, SEEK_SET);
+  if (!dir.empty()) _write(&dir[0], sizeof(OccIndexNode), dir.size(), f);
+  _write(post, 1, total, f);
+  *pos = base+total;
+
+  for (i=0; i<(int)touched.size(); i++) {
+    v = touched[i];
+    _nocc[v] = _bytes[v] = 0;
+    _last[v] = -1;
+  }
+  delete[] post;
+  delete[] buf;
+}
+
+static bool _byAdj(const pair<string, int> &a, const pair<string, int> &b) {
+  return a.first < b.first;
+}
+
+void OccIndex::close(const vector<string> *names) {
+  int i, nc = _classes.size();
+  int nodes = names!=NULL ? (int)names->size() : _max_node+1;
+  long long pos, off;
+  OccIndexHeader h;
+  vector<OccIndexClass> table(nc);
+  vector<pair<string, int> > sorted(nc);
+  vector<int> rank(nc);
+
+  // Classes by adjacency matrix
+  for (i=0; i<nc; i++) sorted[i] = make_pair(_classes[i], i);
+  sort(sorted.begin(), sorted.end(), _byAdj);
+  for (i=0; i<nc; i++) rank[sorted[i].second] = i;
+
+  h.version     = OCCINDEX_VERSION;
+  h.size        = _size;
+  h.classes     = nc;
+  h.nodes       = nodes;
+  h.occurrences = occurrences();
+  h.names       = 0;
+
+  // Fixed part, then the occurrences of each class (8 byte aligned)
+  pos = 8 + sizeof(OccIndexHeader) + nc*sizeof(OccIndexClass) + (long long)nc*_size*_size;
+  if (names != NULL) {
+    h.names = pos = (pos+7) & ~7LL;
+    pos += (nodes+1)*sizeof(long long) + nodes*sizeof(int);
+    for (i=0; i<nodes; i++) pos += (*names)[i].size()+1;
+  }
+  pos = (pos+7) & ~7LL;
+  for (i=0; i<nc; i++) {
+    table[i].count  = _count[sorted[i].second];
+    table[i].occ    = pos;
+    table[i].dir    = 0;
+    table[i].nnodes = 0;
+    table[i].pad    = 0;
+    pos += table[i].count*_size*sizeof(int);
+  }
+
+  FILE *f = fopen(_file, "w+b");
+  if (f==NULL) Error::msg("Unable to open occurrence index file \"%s\"", _file);
+  _group(f, &table[0], &rank[0]);
+
+  _last  = new long long[nodes];
+  _nocc  = new long long[nodes];
+  _bytes = new long long[nodes];
+  for (i=0; i<nodes; i++) {
+    _nocc[i] = _bytes[i] = 0;
+    _last[i] = -1;
+  }
+  for (i=0; i<nc; i++) _postings(f, &table[i], &pos);
+  delete[] _last;
+  delete[] _nocc;
+  delete[] _bytes;
+
+  fseeko(f, 0, SEEK_SET);
+  _write(OCCINDEX_MAGIC, 1, 8, f);
+  _write(&h, sizeof(OccIndexHeader), 1, f);
+  if (nc>0) _write(&table[0], sizeof(OccIndexClass), nc, f);
+  for (i=0; i<nc; i++) _write(sorted[i].first.c_str(), 1, _size*_size, f);
+  if (names != NULL) {
+    vector<pair<string, int> > byname(nodes);
+    fseeko(f, h.names, SEEK_SET);
+    for (i=0, off=0; i<=nodes; i++) {
+      _write(&off, sizeof(long long), 1, f);
+      if (i<nodes) off += (*names)[i].size()+1;
+    }
+    for (i=0; i<nodes; i++) byname[i] = make_pair((*names)[i], i);
+    sort(byname.begin(), byname.end(), _byAdj);
+    for (i=0; i<nodes; i++) _write(&byname[i].second, sizeof(int), 1, f);
+    for (i=0; i<nodes; i++) _write((*names)[i].c_str(), 1, (*names)[i].size()+1, f);
+  }
+  if (fclose(f)!=0) Error::msg(NULL);
+
+  if (fclose(_spill)!=0) Error::msg(NULL);
+  remove(_spill_file);
+  _spill = NULL;
+}
+
+// Index file mapped by query. Every offset read from it is checked
+// against the size of the file before being followed
+typedef struct {
+  const char *m;
+  long long size;           // Bytes of the file
+  const char *file;
+  OccIndexHeader h;
+  const long long *off;     // Names (NULL: labels are numbers)
+  const int *byname;
+  const char *names;
+  long long nlen;           // Bytes of the names
+} OccIndexMap;
+
+static void _corrupt(const OccIndexMap *x) {
+  Error::msg("Corrupt occurrence index file \"%s\"", x->file);
+}
+
+// Are the 'n' items of 'unit' bytes at 'off' inside the file (and aligned to 'align')?
+static bool _inside(const OccIndexMap *x, long long off, long long n, long long unit, int align) {
+  return off>=0 && off<=x->size && off%align==0 && n>=0 && n <= (x->size-off)/unit;
+}
+
+// Name of label 'l'
+static const char *_name(const OccIndexMap *x, int l) {
+  long long a = x->off[l], b = x->off[l+1];
+  if (a<0 || a>=b || b>x->nlen || x->names[b-1]!=0) _corrupt(x);
+  return x->names+a;
+}
+
+// Write occurrence 'o' of a class ('occ': its labels) as on the occurrences file
+static void _writeOcc(FILE *out, const OccIndexMap *x, const char *adj, const int *occ, long long o) {
+  int size = x->h.size;
+  fwrite(adj, 1, size*size, out);
+  fputc(':', out);
+  for (int i=0; i<size; i++) {
+    int l = occ[o*size+i];
+    if (l<0 || l>=x->h.nodes) _corrupt(x);
+    if (x->names==NULL) fprintf(out, " %d", l+1);
+    else                fprintf(out, " %s", _name(x, l));
+  }
+  fputc('\n', out);
+}
+
+long long OccIndex::query(const char *s, const char *adj, const char *node, FILE *out) {
+  struct stat st;
+  OccIndexMap x;
+  OccIndexHeader &h = x.h;
+  char *m, *end;
+  int i, lo, hi, mid, label = -1, first, last, size;
+  long long n = 0, k, o, pos;
+  unsigned long long gap;
+
+  int fd = open(s, O_RDONLY);
+  if (fd<0 || fstat(fd, &st)!=0) Error::msg("Unable to open occurrence index file \"%s\"", s);
+  if ((size_t)st.st_size < 8+sizeof(OccIndexHeader)) {
+    ::close(fd);
+    Error::msg("Invalid occurrence index file \"%s\"", s);
+  }
+  m = (char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (m==MAP_FAILED) Error::msg(NULL);
+
+  x.m    = m;
+  x.size = st.st_size;
+  x.file = s;
+  x.off  = NULL;
+  x.byname = NULL;
+  x.names  = NULL;
+  x.nlen   = 0;
+  if (memcmp(m, OCCINDEX_MAGIC, 8)) Error::msg("Invalid occurrence index file \"%s\"", s);
+  memcpy(&h, m+8, sizeof(OccIndexHeader));
+  if (h.version!=OCCINDEX_VERSION)
+    Error::msg("Invalid occurrence index file \"%s\" (version %d)", s, h.version);
+  if (h.size<1 || h.size>MAX_MOTIF_SIZE || h.classes<0 || h.nodes<0 || h.occurrences<0 ||
+      !_inside(&x, 8+sizeof(OccIndexHeader), h.classes, sizeof(OccIndexClass)+h.size*h.size, 8))
+    _corrupt(&x);
+  madvise(m, st.st_size, MADV_RANDOM);
+
+  size = h.size;
+  const OccIndexClass *table = (const OccIndexClass *)(m+8+sizeof(OccIndexHeader));
+  const char *adjs = (const char *)(table+h.classes);
+  if (h.names != 0) {
+    pos = h.names + (h.nodes+1LL)*sizeof(long long);
+    if (!_inside(&x, h.names, h.nodes+1LL, sizeof(long long), 8) ||
+	!_inside(&x, pos, h.nodes, sizeof(int), 4))
+      _corrupt(&x);
+    x.off    = (const long long *)(m+h.names);
+    x.byname = (const int *)(m+pos);
+    x.names  = (const char *)(x.byname+h.nodes);
+    x.nlen   = x.size - (x.names-m);
+  }
+
+  // Without class nor node: the classes
+  if (adj==NULL && node==NULL) {
+    for (i=0; i<h.classes; i++) {
+      fprintf(out, "%.*s: %lld occurrences, %d nodes\n", size*size, adjs+(long long)i*size*size,
+	      table[i].count, table[i].nnodes);
+      n += table[i].count;
+    }
+    munmap(m, st.st_size);
+    return n;
+  }
+
+  // Label of the node
+  if (node != NULL) {
+    if (x.names != NULL) {
+      for (lo=0, hi=h.nodes-1; lo<=hi && label<0; ) {
+	mid = (lo+hi)/2;
+	int l = x.byname[mid];
+	if (l<0 || l>=h.nodes) _corrupt(&x);
+	int c = strcmp(_name(&x, l), node);
+	if (c==0) label = l;
+	else if (c<0) lo = mid+1;
+	else hi = mid-1;
+      }
+    } else {
+      long v = strtol(node, &end, 10);
+      if (*end==0 && end!=node && v>=1 && v<=h.nodes) label = v-1;
+    }
+    if (label<0) {munmap(m, st.st_size); return 0;}
+  }
+
+  // Classes to look at
+  first = 0;
+  last  = h.classes-1;
+  if (adj != NULL) {
+    first = -1;
+    if ((int)strlen(adj) == size*size)
+      for (lo=0, hi=h.classes-1; lo<=hi && first<0; ) {
+	mid = (lo+hi)/2;
+	int c = memcmp(adjs+(long long)mid*size*size, adj, size*size);
+	if (c==0) first = mid;
+	else if (c<0) lo = mid+1;
+	else hi = mid-1;
+      }
+    if (first<0) {munmap(m, st.st_size); return 0;}
+    last = first;
+  }
+
+  for (i=first; i<=last; i++) {
+    if (!_inside(&x, table[i].occ, table[i].count, (long long)size*sizeof(int), sizeof(int)))
+      _corrupt(&x);
+    const int *occ = (const int *)(m+table[i].occ);
+    const char *a = adjs+(long long)i*size*size;
+    if (label<0) {
+      for (o=0; o<table[i].count; o++) _writeOcc(out, &x, a, occ, o);
+      n += table[i].count;
+      continue;
+    }
+
+    if (!_inside(&x, table[i].dir, table[i].nnodes, sizeof(OccIndexNode), 8)) _corrupt(&x);
+    const OccIndexNode *dir = (const OccIndexNode *)(m+table[i].dir);
+    for (lo=0, hi=table[i].nnodes-1; lo<=hi; ) {
+      mid = (lo+hi)/2;
+      if (dir[mid].node < label) lo = mid+1;
+      else if (dir[mid].node > label) hi = mid-1;
+      else {
+	// Postings are increasing occurrences of the class
+	if (dir[mid].count<0 || dir[mid].count>table[i].count || !_inside(&x, dir[mid].postings, 0, 1, 1))
+	  _corrupt(&x);
+	const unsigned char *p = (const unsigned char *)(m+dir[mid].postings);
+	const unsigned char *pend = (const unsigned char *)(m+x.size);
+	for (k=0, o=-1; k<dir[mid].count; k++) {
+	  p = _getVarint(p, pend, &gap);
+	  if (p==NULL || gap==0 || gap > (unsigned long long)(table[i].count-1-o)) _corrupt(&x);
+	  o += gap;
+	  _writeOcc(out, &x, a, occ, o);
+	}
+	n += dir[mid].count;
+	break;
+      }
+    }
+  }
+
+  munmap(m, st.st_size);
+  return n;
+}
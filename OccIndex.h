@@ -0,0 +1,109 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Index of the occurrences of each subgraph
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _OCCINDEX_
+#define _OCCINDEX_
+
+#include "Common.h"
+#include <unordered_map>
+
+#define OCCINDEX_MAGIC   "GTRIEOCI" // First bytes of an occurrence index file
+#define OCCINDEX_VERSION 2
+#define OCCINDEX_CHUNK   (1<<20)    // Occurrences grouped at a time when building
+
+// An index file has the header, the classes (sorted by adjacency matrix),
+// their adjacency matrices and the node names (if any). Then come the
+// occurrences of each class (the label of each node, in the order they
+// were found) and, for each class, its node directory (sorted by label)
+// followed by the postings of those nodes: the numbers of the occurrences
+// (of that class) with the node, increasing, coded as gaps in varints
+// of 7 bits. Offsets are from the start of the file, and the names and
+// each directory start 8 byte aligned
+typedef struct {
+  int version;
+  int size;              // Subgraph size
+  int classes;
+  int nodes;             // Number of node labels
+  long long occurrences;
+  long long names;       // Offset of the names (0: labels are numbers)
+} OccIndexHeader;
+
+typedef struct {
+  long long count;       // Number of occurrences
+  long long occ;         // Offset of the occurrences (size ints each)
+  long long dir;         // Offset of the node directory
+  int nnodes;            // Nodes on its occurrences (directory entries)
+  int pad;
+} OccIndexClass;
+
+typedef struct {
+  int node;              // Label (from 0)
+  int pad;
+  long long count;       // Occurrences with the node
+  long long postings;    // Offset of its postings
+} OccIndexNode;
+
+// The names are their offsets (nodes+1 long longs, from the first name),
+// the labels in name order (nodes ints) and the names ('\0' terminated)
+
+// Occurrences are appended to a spill file as they are found (class number
+// and labels in binary, cheaper than a text dump) and the index is only
+// built, from that file, when closed
+class OccIndex {
+ private:
+  char _file[MAX_BUF];
+  char _spill_file[MAX_BUF+8];
+  FILE *_spill;
+  int _size;
+  int _max_node;                    // Largest label added
+  int *_rec;                        // Record being added
+
+  vector<string> _classes;          // Adjacency matrix of each class
+  vector<long long> _count;         // Occurrences of each class
+  unordered_map<string, int> _id;   // Number of each class
+  string _key;
+
+  long long *_last;                 // Per node, while building the postings: last occurrence,
+  long long *_nocc;                 // number of occurrences
+  long long *_bytes;                // and bytes of its postings
+
+  void _group(FILE *f, OccIndexClass *table, const int *rank);
+  void _postings(FILE *f, OccIndexClass *c, long long *pos);
+
+ public:
+  OccIndex(const char *s, int size); // Index for file 's' of subgraphs of 'size'
+  ~OccIndex();
+
+  // Occurrence of the subgraph with adjacency matrix 'adj' on the nodes
+  // with 'labels' (from 0, as on the graph file)
+  void add(const char *adj, const int *labels);
+
+  // Write the index file ('names': identifier of each label, NULL if numbers)
+  void close(const vector<string> *names);
+
+  long long occurrences();
+
+  // Write the occurrences of class 'adj' with node 'node' (as on the graph
+  // file) of index file 's' to 'out', like the occurrences file. Any of them
+  // may be NULL (all classes / all nodes): with none, write each class and
+  // its number of occurrences. Returns the number of occurrences written
+  static long long query(const char *s, const char *adj, const char *node, FILE *out);
+};
+
+#endif
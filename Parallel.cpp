@@ -0,0 +1,67 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Parallel work on forked processes (with deterministic merge)
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Parallel.h"
+#include "Error.h"
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Static variables
+int Parallel::_jobs = 1;
+
+void Parallel::run(int n, ParallelWork work, ParallelMerge merge, void *arg) {
+  int i, status, nproc = min(_jobs, n);
+
+  if (nproc<=1) {
+    FILE *f = tmpfile();
+    if (f==NULL) Error::msg(NULL);
+    work(0, n, f, arg);
+    rewind(f);
+    merge(f, arg);
+    fclose(f);
+    return;
+  }
+
+  FILE *out[nproc];
+  pid_t pid[nproc];
+
+  // Buffered output would be written again by every child
+  fflush(stdout);
+  fflush(stderr);
+
+  for (i=0; i<nproc; i++) {
+    out[i] = tmpfile();
+    if (out[i]==NULL) Error::msg(NULL);
+    pid[i] = fork();
+    if (pid[i]<0) Error::msg("Unable to create process %d", i);
+    if (pid[i]==0) {
+      work((long long)n*i/nproc, (long long)n*(i+1)/nproc, out[i], arg);
+      _exit(fflush(out[i])==0 && !ferror(out[i]) ? 0 : 1);
+    }
+  }
+
+  // Results of the first ranges are merged while the others still run
+  for (i=0; i<nproc; i++) {
+    if (waitpid(pid[i], &status, 0)<0 || !WIFEXITED(status) || WEXITSTATUS(status)!=0)
+      Error::msg("Process %d (of %d) failed", i, nproc);
+    rewind(out[i]);
+    merge(out[i], arg);
+    fclose(out[i]);
+  }
+}
@@ -0,0 +1,46 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Parallel work on forked processes (with deterministic merge)
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _PARALLEL_
+#define _PARALLEL_
+
+#include "Common.h"
+
+// Work on items [first, last), writing the results to 'out'
+typedef void (*ParallelWork)(int first, int last, FILE *out, void *arg);
+
+// Read the results written by one ParallelWork call
+typedef void (*ParallelMerge)(FILE *in, void *arg);
+
+// Work is split by contiguous ranges of items, one per process, and the
+// results are merged in range order, so they do not depend on the number
+// of processes. Processes share nothing (nauty is not thread safe)
+class Parallel {
+ private:
+  static int _jobs;
+
+ public:
+  static void setJobs(int n) {_jobs = n<1 ? 1 : n;}
+  static int  jobs()         {return _jobs;}
+
+  // Run 'work' over 'n' items on (up to) jobs() processes and 'merge' their results
+  static void run(int n, ParallelWork work, ParallelMerge merge, void *arg);
+};
+
+#endif
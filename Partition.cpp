@@ -0,0 +1,134 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Partitioned census (distributing work by root node)
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Partition.h"
+#include "Error.h"
+#include <queue>
+
+// Static variables
+int   Partition::_part   = 0;
+int   Partition::_nparts = 0;
+bool *Partition::_mine   = NULL;
+
+// Assign root nodes of 'g' to 'nparts' partitions: nodes are taken by decreasing
+// degree and each one goes to the partition with smaller total degree so far
+// (ties broken by partition number, so every process gets the same assignment)
+void Partition::assign(Graph *g, int part, int nparts) {
+  int i, num_nodes = g->numNodes();
+  vector<iPair> order(num_nodes);
+  priority_queue< pair<long long, int>,
+		  vector< pair<long long, int> >,
+		  greater< pair<long long, int> > > load;
+
+  clear();
+  _part   = part;
+  _nparts = nparts;
+  _mine   = new bool[num_nodes];
+
+  for (i=0; i<num_nodes; i++) {
+    order[i].first  = -g->numNeighbours(i);
+    order[i].second = i;
+  }
+  sort(order.begin(), order.end());
+
+  for (i=0; i<nparts; i++)
+    load.push(make_pair(0LL, i));
+
+  for (i=0; i<num_nodes; i++) {
+    pair<long long, int> p = load.top();
+    load.pop();
+    _mine[order[i].second] = (p.second == part);
+    p.first += 1 - order[i].first; // node degree (+1 so that isolated nodes also spread)
+    load.push(p);
+  }
+}
+
+void Partition::clear() {
+  if (_mine!=NULL) delete[] _mine;
+  _mine   = NULL;
+  _nparts = 0;
+  _part   = 0;
+}
+
+// Parse "i/N" partition string, with 0 <= i < N
+bool Partition::parse(const char *s, int *part, int *nparts) {
+  if (sscanf(s, "%d/%d", part, nparts)!=2) return false;
+  return *nparts>0 && *part>=0 && *part<*nparts;
+}
+
+// Write partial results to file 's'
+void Partition::writeResults(const char *s, PartialHeader *h, const char *graph, vector<mapStringInt> &m) {
+  int i, len, version = PARTIAL_VERSION;
+  mapStringInt::const_iterator ii, iiend;
+
+  FILE *f = fopen(s, "wb");
+  if (f==NULL) Error::msg("Unable to open partial results file \"%s\"", s);
+
+  fwrite(PARTIAL_MAGIC, 1, 8, f);
+  fwrite(&version, sizeof(int), 1, f);
+  fwrite(h, sizeof(PartialHeader), 1, f);
+  len = strlen(graph);
+  fwrite(&len, sizeof(int), 1, f);
+  fwrite(graph, 1, len, f);
+
+  for (i=0; i<=h->random_number; i++) {
+    len = m[i].size();
+    fwrite(&len, sizeof(int), 1, f);
+    for (ii=m[i].begin(), iiend=m[i].end(); ii!=iiend; ++ii) {
+      fwrite((ii->first).c_str(), 1, h->motif_size*h->motif_size, f);
+      fwrite(&ii->second, sizeof(int), 1, f);
+    }
+  }
+
+  if (fclose(f)!=0) Error::msg(NULL);
+}
+
+// Read partial results from file 's' and add frequencies to 'm'
+void Partition::readResults(const char *s, PartialHeader *h, char *graph, vector<mapStringInt> &m) {
+  int i, j, len, num, freq, version;
+  char magic[8];
+
+  FILE *f = fopen(s, "rb");
+  if (f==NULL) Error::msg("Unable to open partial results file \"%s\"", s);
+
+  if (fread(magic, 1, 8, f)!=8 || memcmp(magic, PARTIAL_MAGIC, 8) ||
+      fread(&version, sizeof(int), 1, f)!=1 || version!=PARTIAL_VERSION ||
+      fread(h, sizeof(PartialHeader), 1, f)!=1 ||
+      fread(&len, sizeof(int), 1, f)!=1 || len<0 || len>=MAX_BUF ||
+      fread(graph, 1, len, f)!=(size_t)len)
+    Error::msg("Invalid partial results file \"%s\"", s);
+  graph[len] = 0;
+
+  int size = h->motif_size*h->motif_size;
+  char buf[size+1];
+  buf[size] = 0;
+
+  if ((int)m.size() < h->random_number+1) m.resize(h->random_number+1);
+  for (i=0; i<=h->random_number; i++) {
+    if (fread(&num, sizeof(int), 1, f)!=1)
+      Error::msg("Truncated partial results file \"%s\"", s);
+    for (j=0; j<num; j++) {
+      if (fread(buf, 1, size, f)!=(size_t)size || fread(&freq, sizeof(int), 1, f)!=1)
+	Error::msg("Truncated partial results file \"%s\"", s);
+      m[i][buf] += freq;
+    }
+  }
+
+  fclose(f);
+}
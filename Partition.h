@@ -0,0 +1,72 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Partitioned census (distributing work by root node)
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _PARTITION_
+#define _PARTITION_
+
+#include "Common.h"
+#include "Graph.h"
+
+#define PARTIAL_MAGIC   "GTRIEPRT" // First bytes of a partial results file
+#define PARTIAL_VERSION 2
+
+// Parameters of a partial computation (must be equal on all partitions)
+typedef struct {
+  int motif_size;
+  int dir;
+  int method;
+  int nodes;
+  int edges;
+  int random_number;
+  int random_seed;
+  int random_exchanges;
+  int random_tries;
+  int nparts;
+  int part;
+  int order;
+  double time_original;
+  double time_random;
+} PartialHeader;
+
+class Partition {
+ private:
+  static int  _part;   // This partition
+  static int  _nparts; // Number of partitions (0 = no partitioning)
+  static bool *_mine;  // Root nodes belonging to this partition
+
+ public:
+  // Assign root nodes of 'g' to 'nparts' partitions, balancing degrees,
+  // and keep the ones of partition 'part'
+  static void assign(Graph *g, int part, int nparts);
+  static void clear();
+
+  static bool active()     {return _nparts>0;}
+  static bool owns(int v)  {return _mine==NULL || _mine[v];}
+  static const bool *roots() {return _mine;} // NULL if all
+
+  // Parse "i/N" partition string (false if invalid)
+  static bool parse(const char *s, int *part, int *nparts);
+
+  // Partial results: frequencies of original network (m[0])
+  // and of each random network (m[1..random_number])
+  static void writeResults(const char *s, PartialHeader *h, const char *graph, vector<mapStringInt> &m);
+  static void readResults(const char *s, PartialHeader *h, char *graph, vector<mapStringInt> &m); // adds to 'm'
+};
+
+#endif
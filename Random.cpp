@@ -14,14 +14,36 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Randomization methods
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #include "Random.h"
 
+// Static variables
+char  Random::_buf[2][RANDOM_STATE_SIZE];
+char *Random::_active = NULL;
+
 // Initialize pseudo-random generator with seed 's'
+// (same sequence as srandom, but with a state we can save and restore)
 void Random::seed(int s) {
-  srandom(s);
+  _active = _buf[0];
+  initstate(s, _active, RANDOM_STATE_SIZE);
+}
+
+// Copy generator state to 's'
+void Random::getState(char *s) {
+  if (_active == NULL) seed(1);
+  setstate(_active); // forces current position to be stored on the buffer
+  memcpy(s, _active, RANDOM_STATE_SIZE);
+}
+
+// Restore generator state previously saved on 's'
+// (setstate() writes on the old buffer, so we switch to the spare one)
+void Random::setState(const char *s) {
+  char *spare = (_active == _buf[0]) ? _buf[1] : _buf[0];
+  memcpy(spare, s, RANDOM_STATE_SIZE);
+  setstate(spare);
+  _active = spare;
 }
 
 // Pseudo-Random number between 'a' and 'b' (inclusive)
@@ -37,6 +59,10 @@ double Random::getDouble() {
 
   // Randomize 'g' network with 'num' exchanges per edge and 'tries' attempts per edge
 void Random::markovChainPerEdge(Graph *g, int num, int tries) {
+  markovChainPerEdge(g, num, tries, NULL, NULL);
+}
+
+void Random::markovChainPerEdge(Graph *g, int num, int tries, SwapHook hook, void *arg) {
   int i, j, k, n, edges, nodes = g->numNodes();
   int a, b, c, d, aux;
   vector<int> *v, *u;
@@ -69,6 +95,7 @@ void Random::markovChainPerEdge(Graph *g, int num, int tries) {
 	    g->rmEdge(b,a);  g->rmEdge(d,c);
 	    g->addEdge(d,a); g->addEdge(b,c);
 	  }
+	  if (hook!=NULL) hook(a,b,c,d,arg);
 	}
       }
     }
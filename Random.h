@@ -14,7 +14,7 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Randomization methods
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #ifndef _RANDOM_
@@ -23,15 +23,26 @@ Last Update: 11/02/2012
 #include "Common.h"
 #include "Graph.h"
 
+#define RANDOM_STATE_SIZE 128 // Size of the generator state (same as srandom)
+
+// Called after each swap of edges a-b and c-d to a-d and c-b
+typedef void (*SwapHook)(int a, int b, int c, int d, void *arg);
+
 class Random {
+ private:
+  static char _buf[2][RANDOM_STATE_SIZE]; // State buffers (one active, one spare)
+  static char *_active;                   // Buffer currently used by random()
 
  public:
   static void seed(int s);             // Initialize pseudo-random generator with seed 's'
+  static void getState(char *s);       // Copy generator state to 's' (RANDOM_STATE_SIZE bytes)
+  static void setState(const char *s); // Restore generator state previously saved on 's'
   static int getInteger(int a, int b); // Pseudo-Random number between 'a' and 'b' (inclusive)
   static double getDouble();           // Pseudo-Random number between 0 and 1
     
   // Randomize 'g' network with 'num' exchanges per edge and 'tries' attempts per edge
   static void markovChainPerEdge(Graph *g, int num, int tries);
+  static void markovChainPerEdge(Graph *g, int num, int tries, SwapHook hook, void *arg);
 };
 
 #endif
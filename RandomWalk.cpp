@@ -0,0 +1,157 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Random walk estimates of subgraph concentrations
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "RandomWalk.h"
+#include "Isomorphism.h"
+#include "Random.h"
+#include "Error.h"
+
+RandomWalk::RandomWalk(Graph *g, int size) {
+  _g    = g;
+  _size = size;
+  _set  = new int[size];
+  _ways = new long long[size];
+  _mark = new int[g->numNodes()];
+  for (int i=0; i<g->numNodes(); i++) _mark[i] = 0;
+  _stamp = 0;
+}
+
+RandomWalk::~RandomWalk() {
+  delete[] _set;
+  delete[] _ways;
+  delete[] _mark;
+}
+
+// Is the subgraph still connected without its i-th node?
+bool RandomWalk::_connectedWithout(int i) {
+  int j, l, n = 1, queue[_size];
+  bool seen[_size];
+
+  for (j=0; j<_size; j++) seen[j] = false;
+  seen[i] = true;
+  queue[0] = (i==0) ? 1 : 0;
+  seen[queue[0]] = true;
+  for (j=0; j<n; j++)
+    for (l=0; l<_size; l++)
+      if (!seen[l] && _g->isConnected(_set[queue[j]], _set[l])) {
+	seen[l] = true;
+	queue[n++] = l;
+      }
+  return n == _size-1;
+}
+
+// Nodes that can replace the i-th node of the subgraph: the neighbours of
+// the others that are not on it. If 'pick'>=0, the pick-th of them
+// replaces it. Returns how many they are
+long long RandomWalk::_replacements(int i, long long pick) {
+  int j, l, v, num, *nei;
+  long long n = 0;
+
+  _stamp++;
+  for (j=0; j<_size; j++) _mark[_set[j]] = _stamp;
+  for (j=0; j<_size; j++) {
+    if (j==i) continue;
+    nei = _g->arrayNeighbours(_set[j]);
+    num = _g->numNeighbours(_set[j]);
+    for (l=0; l<num; l++) {
+      v = nei[l];
+      if (_mark[v] == _stamp) continue;
+      _mark[v] = _stamp;
+      if (n++ == pick) {
+	_set[i] = v;
+	return n;
+      }
+    }
+  }
+  return n;
+}
+
+// Number of neighbours of the subgraph (kept by node on _ways)
+long long RandomWalk::_neighbours() {
+  long long d = 0;
+  for (int i=0; i<_size; i++) {
+    _ways[i] = _connectedWithout(i) ? _replacements(i, -1) : 0;
+    d += _ways[i];
+  }
+  return d;
+}
+
+// First subgraph: a random node grown by random neighbours
+bool RandomWalk::_start() {
+  int t, i, j, l, n, num, *nei, cand;
+  int nodes = _g->numNodes();
+
+  for (t=0; t<WALK_MAX_TRIES; t++) {
+    _set[0] = Random::getInteger(0, nodes-1);
+    for (n=1; n<_size; n++) {
+      // uniform neighbour of the nodes so far
+      _stamp++;
+      for (i=0; i<n; i++) _mark[_set[i]] = _stamp;
+      for (i=0, cand=0; i<n; i++) {
+	nei = _g->arrayNeighbours(_set[i]);
+	num = _g->numNeighbours(_set[i]);
+	for (j=0; j<num; j++)
+	  if (_mark[nei[j]] != _stamp) {
+	    _mark[nei[j]] = _stamp;
+	    if (Random::getInteger(0, cand++) == 0) l = nei[j];
+	  }
+      }
+      if (cand == 0) break;
+      _set[n] = l;
+    }
+    if (n == _size) return true;
+  }
+  return false;
+}
+
+int RandomWalk::walk(int s, int steps, map<string, double> *conc) {
+  int i, t;
+  long long d, r;
+  double total = 0;
+  char str[_size*_size+1];
+  map<string, double> w;
+  map<string, double>::iterator ii;
+
+  Random::seed(s);
+  if (!_start())
+    Error::msg("No connected %d-subgraph found from %d random nodes", _size, WALK_MAX_TRIES);
+
+  for (t=0; t<WALK_BURN_IN+steps; t++) {
+    d = _neighbours();
+    if (d == 0) { // only subgraph of its component: start again elsewhere
+      _start();
+      continue;
+    }
+    if (t >= WALK_BURN_IN) {
+      Isomorphism::canonicalStrNauty(_g, _set, str);
+      w[str] += 1.0/d;
+      total  += 1.0/d;
+    }
+
+    // Uniform neighbour: a node to replace (by its number of ways), then its replacement
+    r = (long long)(Random::getDouble()*d);
+    if (r >= d) r = d-1;
+    for (i=0; r >= _ways[i]; i++) r -= _ways[i];
+    _replacements(i, r);
+  }
+
+  for (ii=w.begin(); ii!=w.end(); ii++)
+    (*conc)[ii->first] += ii->second / total;
+  return w.size();
+}
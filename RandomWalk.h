@@ -0,0 +1,61 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Random walk estimates of subgraph concentrations
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _RANDOMWALK_
+#define _RANDOMWALK_
+
+#include "Common.h"
+#include "Graph.h"
+
+#define WALK_BURN_IN   1000 // Steps of each walk before the subgraphs are counted
+#define WALK_MAX_TRIES 1000 // Attempts to find a first subgraph (from random nodes)
+
+// Estimates the concentrations of the k-subgraphs of a graph by a random
+// walk over its connected k-subgraphs, where two of them are neighbours if
+// they share k-1 nodes (replacing one node by a node next to the others).
+// Each step goes to a uniform neighbour, so in the long run subgraphs are
+// visited in proportion to their number of neighbours d. Counting each
+// visit with weight 1/d, the concentration of each class is its share of
+// the weights (the estimates converge to the exact concentrations).
+// Edge direction is ignored for the walk (not for the classes).
+class RandomWalk {
+ private:
+  Graph *_g;
+  int _size;
+  int *_set;              // Current subgraph
+  int *_mark;             // Nodes already seen on this pass (see _stamp)
+  int _stamp;
+  long long *_ways;       // Neighbours of the subgraph replacing each of its nodes
+
+  bool _connectedWithout(int i);
+  long long _replacements(int i, long long pick);
+  long long _neighbours();
+  bool _start();
+
+ public:
+  RandomWalk(Graph *g, int size); // Needs Isomorphism::initNauty
+  ~RandomWalk();
+
+  // Walk 'steps' steps (after WALK_BURN_IN) from a random subgraph (seed 's'),
+  // adding the concentration of each class visited (canonical adjacency
+  // strings) to 'conc'. Returns the number of distinct classes
+  int walk(int s, int steps, map<string, double> *conc);
+};
+
+#endif
@@ -0,0 +1,210 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Operations on sorted sets of integers (neighbour lists)
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "SetOps.h"
+#include "Error.h"
+
+#include <immintrin.h>
+
+SetOpsType SetOps::_type = SETOPS_SCALAR;
+
+// Compaction tables: move the lanes selected by a mask to the front
+static unsigned char _shuffle_sse[16][16];
+static int _permute_avx2[256][8];
+
+// ------------------------------
+// Scalar kernel
+// ------------------------------
+
+// First position of [p, end) with value >= x, searching from 'p' with
+// exponentially growing steps
+static inline const int *_gallop(const int *p, const int *end, int x) {
+  int step = 1;
+
+  while (p+step < end && p[step] < x) step <<= 1;
+  return lower_bound(p+step/2, min(p+step+1, end), x);
+}
+
+static int _intersect_scalar(const int *a, int na, const int *b, int nb, int *out) {
+  const int *ea = a+na, *eb = b+nb;
+  int k = 0;
+
+  if (nb > SETOPS_GALLOP*na) {
+    for (; a<ea && b<eb; a++) {
+      b = _gallop(b, eb, *a);
+      if (b<eb && *b==*a) out[k++] = *a;
+    }
+  } else if (na > SETOPS_GALLOP*nb) {
+    for (; a<ea && b<eb; b++) {
+      a = _gallop(a, ea, *b);
+      if (a<ea && *a==*b) out[k++] = *b;
+    }
+  } else {
+    while (a<ea && b<eb) {
+      if      (*a < *b) a++;
+      else if (*b < *a) b++;
+      else {out[k++] = *a; a++; b++;}
+    }
+  }
+
+  return k;
+}
+
+// Finish a block-wise intersection: lanes of the current block of 'a' below
+// b[j] are settled by 'found', the rest goes to the scalar kernel
+static inline int _tail(const int *a, int na, int i, const int *b, int nb, int j,
+                        unsigned found, int *out, int k) {
+  if (found) {
+    for (int t=0; i<na && (j==nb || a[i]<b[j]); i++, t++)
+      if (t<8 && ((found>>t)&1)) out[k++] = a[i];
+  }
+  return k + _intersect_scalar(a+i, na-i, b+j, nb-j, out+k);
+}
+
+// ------------------------------
+// SSE kernel (4 x 4 all-pairs comparison)
+// ------------------------------
+
+__attribute__((target("sse4.2")))
+static int _block_sse(const int *a, int na, const int *b, int nb, int *out) {
+  int i = 0, j = 0, k = 0, amax, bmax;
+  unsigned found = 0;
+  __m128i va, vb, m;
+
+  while (i+4<=na && j+4<=nb) {
+    va = _mm_loadu_si128((const __m128i *)(a+i));
+    vb = _mm_loadu_si128((const __m128i *)(b+j));
+    m  = _mm_cmpeq_epi32(va, vb);
+    m  = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0,3,2,1))));
+    m  = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1,0,3,2))));
+    m  = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2,1,0,3))));
+    found |= _mm_movemask_ps(_mm_castsi128_ps(m));
+
+    amax = a[i+3];
+    bmax = b[j+3];
+    if (amax <= bmax) {
+      m = _mm_loadu_si128((const __m128i *)_shuffle_sse[found]);
+      _mm_storeu_si128((__m128i *)(out+k), _mm_shuffle_epi8(va, m));
+      k += __builtin_popcount(found);
+      found = 0;
+      i += 4;
+    }
+    if (bmax <= amax) j += 4;
+  }
+
+  return _tail(a, na, i, b, nb, j, found, out, k);
+}
+
+__attribute__((target("sse4.2")))
+static int _intersect_sse(const int *a, int na, const int *b, int nb, int *out) {
+  if (nb > SETOPS_GALLOP*na || na > SETOPS_GALLOP*nb) return _intersect_scalar(a, na, b, nb, out);
+  return _block_sse(a, na, b, nb, out);
+}
+
+// ------------------------------
+// AVX2 kernel (8 x 8 all-pairs comparison)
+// ------------------------------
+
+__attribute__((target("avx2")))
+static int _block_avx2(const int *a, int na, const int *b, int nb, int *out) {
+  int i = 0, j = 0, k = 0, amax, bmax;
+  unsigned found = 0;
+  __m256i va, vb, vs, m;
+
+  while (i+8<=na && j+8<=nb) {
+    va = _mm256_loadu_si256((const __m256i *)(a+i));
+    vb = _mm256_loadu_si256((const __m256i *)(b+j));
+    vs = _mm256_permute2x128_si256(vb, vb, 1); // swap 128-bit lanes
+    // rotations inside each lane, of 'vb' and of 'vs', cover all pairs
+    m  = _mm256_cmpeq_epi32(va, vb);
+    m  = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(0,3,2,1))));
+    m  = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(1,0,3,2))));
+    m  = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(2,1,0,3))));
+    m  = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, vs));
+    m  = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(0,3,2,1))));
+    m  = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(1,0,3,2))));
+    m  = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(2,1,0,3))));
+    found |= _mm256_movemask_ps(_mm256_castsi256_ps(m));
+
+    amax = a[i+7];
+    bmax = b[j+7];
+    if (amax <= bmax) {
+      m = _mm256_loadu_si256((const __m256i *)_permute_avx2[found]);
+      _mm256_storeu_si256((__m256i *)(out+k), _mm256_permutevar8x32_epi32(va, m));
+      k += __builtin_popcount(found);
+      found = 0;
+      i += 8;
+    }
+    if (bmax <= amax) j += 8;
+  }
+
+  return _tail(a, na, i, b, nb, j, found, out, k);
+}
+
+__attribute__((target("avx2")))
+static int _intersect_avx2(const int *a, int na, const int *b, int nb, int *out) {
+  if (nb > SETOPS_GALLOP*na || na > SETOPS_GALLOP*nb) return _intersect_scalar(a, na, b, nb, out);
+  return _block_avx2(a, na, b, nb, out);
+}
+
+// ------------------------------
+
+SetOpFunc SetOps::_intersect = _intersect_scalar;
+
+void SetOps::init(SetOpsType t) {
+  int m, i, j, k;
+
+  for (m=0; m<16; m++) {
+    for (i=0, k=0; i<4; i++)
+      if (m & (1<<i))
+	for (j=0; j<4; j++) _shuffle_sse[m][k++] = 4*i+j;
+    while (k<16) _shuffle_sse[m][k++] = 0x80;
+  }
+  for (m=0; m<256; m++) {
+    for (i=0, k=0; i<8; i++)
+      if (m & (1<<i)) _permute_avx2[m][k++] = i;
+    while (k<8) _permute_avx2[m][k++] = 0;
+  }
+
+  __builtin_cpu_init();
+  if (t == SETOPS_AUTO) {
+    if      (__builtin_cpu_supports("avx2"))   t = SETOPS_AVX2;
+    else if (__builtin_cpu_supports("sse4.2")) t = SETOPS_SSE;
+    else                                       t = SETOPS_SCALAR;
+  }
+  if (t == SETOPS_AVX2 && !__builtin_cpu_supports("avx2"))
+    Error::msg("AVX2 not supported by this CPU");
+  if (t == SETOPS_SSE && !__builtin_cpu_supports("sse4.2"))
+    Error::msg("SSE4.2 not supported by this CPU");
+
+  _type = t;
+  if (t == SETOPS_AVX2) {
+    _intersect = _intersect_avx2;
+  } else if (t == SETOPS_SSE) {
+    _intersect = _intersect_sse;
+  } else {
+    _intersect = _intersect_scalar;
+  }
+}
+
+const char *SetOps::name() {
+  if (_type == SETOPS_AVX2) return "avx2";
+  if (_type == SETOPS_SSE)  return "sse4.2";
+  return "scalar";
+}
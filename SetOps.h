@@ -0,0 +1,50 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Operations on sorted sets of integers (neighbour lists)
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _SETOPS_
+#define _SETOPS_
+
+#include "Common.h"
+
+#define SETOPS_GALLOP 16 // Gallop when one set is this many times larger
+
+typedef enum {SETOPS_AUTO, SETOPS_SCALAR, SETOPS_SSE, SETOPS_AVX2} SetOpsType;
+
+typedef int (*SetOpFunc)(const int *a, int na, const int *b, int nb, int *out);
+
+// All sets are sorted arrays without repeated elements.
+// Results are written to 'out' (which can be the same as 'a' and must
+// have room for 'na' elements) and their size is returned.
+class SetOps {
+ private:
+  static SetOpsType _type;
+  static SetOpFunc  _intersect;
+
+ public:
+  // Choose kernels (SETOPS_AUTO: best supported by the CPU)
+  static void init(SetOpsType t);
+  static const char *name();
+
+  // Elements of 'a' also on 'b'
+  static int intersect(const int *a, int na, const int *b, int nb, int *out) {
+    return _intersect(a, na, b, nb, out);
+  }
+};
+
+#endif
@@ -0,0 +1,151 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Triad census (subgraphs of size 3) in closed form
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Triads.h"
+#include "Isomorphism.h"
+#include "Parallel.h"
+#include "Generator.h"
+#include "SetOps.h"
+#include "Error.h"
+
+map<string, string> Triads::_class[2];
+
+// Census split over processes (see Triads::census)
+typedef struct {
+  Graph *g;
+  long long *count;
+} TriadsJob;
+
+// Centres [first, last) and the triangles whose smallest node is one of them
+void Triads::_count(Graph *g, int first, int last, long long *count) {
+  int i, j, k, v, w, u, n, m, c, *nv, *nw, *common;
+  int dvw, dvu, dwu;
+  int maxdeg = 0;
+  long long t[4];
+  bool dir = (g->type() == DIRECTED);
+
+  for (v=first; v<last; v++) maxdeg = max(maxdeg, g->numNeighbours(v));
+  common = new int[maxdeg+1];
+
+  for (v=first; v<last; v++) {
+    nv = g->arrayNeighbours(v);
+    n  = g->numNeighbours(v);
+
+    // Every pair of neighbours of v
+    t[1] = t[2] = t[3] = 0;
+    for (i=0; i<n; i++) t[_dyad(g, v, nv[i])]++;
+    for (i=1; i<=3; i++)
+      for (j=i; j<=3; j++)
+	count[_code(i, j, 0)] += (i==j) ? t[i]*(t[i]-1)/2 : t[i]*t[j];
+
+    // Triangles v < w < u
+    for (i=0; i<n; i++) {
+      w = nv[i];
+      if (w < v) continue;
+      nw = g->arrayNeighbours(w);
+      m  = g->numNeighbours(w);
+      j  = upper_bound(nw, nw+m, w) - nw;
+      c  = SetOps::intersect(nv+i+1, n-i-1, nw+j, m-j, common);
+      if (!dir) {
+	count[_code(3, 3, 3)] += c;
+	count[_code(3, 3, 0)] -= 3*c;
+	continue;
+      }
+      for (k=0; k<c; k++) {
+	u = common[k];
+	dvw = _dyad(g, v, w);
+	dvu = _dyad(g, v, u);
+	dwu = _dyad(g, w, u);
+	count[_code(dvw, dvu, dwu)]++;
+	count[_code(dvw, dvu, 0)]--;
+	count[_code(_swap(dvw), dwu, 0)]--;
+	count[_code(_swap(dvu), _swap(dwu), 0)]--;
+      }
+    }
+  }
+  delete[] common;
+}
+
+void Triads::_work(int first, int last, FILE *out, void *arg) {
+  long long count[TRIAD_CODES];
+
+  memset(count, 0, sizeof(count));
+  _count(((TriadsJob *)arg)->g, first, last, count);
+  fwrite(count, sizeof(long long), TRIAD_CODES, out);
+}
+
+void Triads::_merge(FILE *in, void *arg) {
+  long long *count = ((TriadsJob *)arg)->count, part[TRIAD_CODES];
+
+  if (fread(part, sizeof(long long), TRIAD_CODES, in)!=TRIAD_CODES)
+    Error::msg("Incomplete triad census results");
+  for (int i=0; i<TRIAD_CODES; i++) count[i] += part[i];
+}
+
+void Triads::census(Graph *g, long long *count) {
+  TriadsJob job = {g, count};
+
+  memset(count, 0, TRIAD_CODES*sizeof(long long));
+  Parallel::run(g->numNodes(), _work, _merge, &job);
+}
+
+// Class strings are those of a g-trie with all the connected triads
+// (see GTrie::insertSubgraphs), indexed by their nauty canonical form
+void Triads::_classes(bool dir) {
+  int i;
+  vector<string> v;
+  char canon[10], larger[10];
+
+  if (!_class[dir].empty()) return;
+  Generator::connectedGraphs(3, dir, v);
+  for (i=0; i<(int)v.size(); i++) {
+    Isomorphism::canonicalNauty(v[i].c_str(), canon, 3);
+    Isomorphism::canonicalBasedNauty(v[i].c_str(), larger, 3);
+    _class[dir][canon] = larger;
+  }
+}
+
+void Triads::populateGraphTree(const long long *count, bool dir, GraphTree *sg) {
+  int i, d[3];
+  char s[10], canon[10];
+  map<string, long long> freq;
+  map<string, long long>::iterator ii;
+  map<string, string>::iterator jj;
+
+  _classes(dir);
+  for (jj=_class[dir].begin(); jj!=_class[dir].end(); jj++)
+    freq[jj->second] = 0; // Every class is reported, as in a complete g-trie
+  for (i=0; i<TRIAD_CODES; i++) {
+    if (count[i] == 0) continue;
+    d[0] = i&3; d[1] = (i>>2)&3; d[2] = (i>>4)&3; // (0,1), (0,2), (1,2)
+    s[0] = s[4] = s[8] = '0';
+    s[1] = '0'+(d[0]&1); s[3] = '0'+(d[0]>>1);
+    s[2] = '0'+(d[1]&1); s[6] = '0'+(d[1]>>1);
+    s[5] = '0'+(d[2]&1); s[7] = '0'+(d[2]>>1);
+    s[9] = 0;
+    Isomorphism::canonicalNauty(s, canon, 3);
+    freq[_class[dir][canon]] += count[i]; // (open triads of a class may have several codes)
+  }
+  for (ii=freq.begin(); ii!=freq.end(); ii++) {
+    strcpy(s, ii->first.c_str());
+    if (ii->second > INT_MAX) // (results keep int frequencies)
+      Error::msg("Frequency of subgraph %s (%lld) is larger than %d", s, ii->second, INT_MAX);
+    sg->setString(s, ii->second);
+  }
+}
@@ -0,0 +1,60 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Triad census (subgraphs of size 3) in closed form
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#ifndef _TRIADS_
+#define _TRIADS_
+
+#include "Common.h"
+#include "Graph.h"
+#include "GraphTree.h"
+
+#define TRIAD_CODES 64 // Dyads of the three pairs of a triad (see Triads::_code)
+
+// Frequencies of the connected subgraphs of size 3 without enumerating
+// them. A triad is open (a centre with two non adjacent neighbours) or a
+// triangle. The open triads of each centre follow from how many of its
+// neighbours are out, in or mutual (reciprocal) neighbours, counting
+// every pair of them, and each triangle, found by intersecting the sorted
+// neighbours of the endpoints of one of its edges, removes the three
+// pairs it had added (one per corner). Centres are split over
+// Parallel::jobs() processes.
+class Triads {
+ private:
+  // Dyad from a to b: 1 (a->b), 2 (b->a) or 3 (both)
+  static int _dyad(Graph *g, int a, int b) {return g->hasEdge(a, b) | (g->hasEdge(b, a)<<1);}
+  // Triad with dyads (0,1), (0,2) and (1,2) (0: no edge)
+  static int _code(int d01, int d02, int d12) {return d01 | (d02<<2) | (d12<<4);}
+  static int _swap(int d) {return ((d&1)<<1) | (d>>1);}
+
+  static map<string, string> _class[2]; // Class of each canonical triad (by direction)
+
+  static void _classes(bool dir);
+  static void _count(Graph *g, int first, int last, long long *count);
+  static void _work(int first, int last, FILE *out, void *arg);
+  static void _merge(FILE *in, void *arg);
+
+ public:
+  // Frequency of each triad code on 'g' (TRIAD_CODES entries)
+  static void census(Graph *g, long long *count);
+
+  // Frequencies by class, with the strings of a g-trie (needs Isomorphism::initNauty)
+  static void populateGraphTree(const long long *count, bool dir, GraphTree *sg);
+};
+
+#endif
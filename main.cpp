@@ -14,15 +14,11 @@ Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
 ----------------------------------------------------
 Main File
 
-Last Update: 11/02/2012
+Last Update: 19/10/2026
 ---------------------------------------------------- */
 
 #include "CmdLine.h"
 
-// "Global" Variables (acessible on every src file)
-bool  Global::show_occ;
-FILE *Global::occ_file;
-
 // Main Function
 int main(int argc, char **argv) {
 
@@ -0,0 +1,409 @@
+#!/bin/bash
+# gtrieScanner: quick discovery of network motifs
+#
+# Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+# ------------------------------------------------
+# Behaviour checks: every method is compared with a plain ESU census
+# (or with another way of getting the same result) on the small
+# networks of this directory.
+#
+# Usage: tests/check.sh [executable]   (or 'make check')
+# (the executable is ../gtrieScanner by default)
+# ------------------------------------------------
+
+DIR=$(cd "$(dirname "$0")" && pwd)
+BIN=${1:-$DIR/../gtrieScanner}
+BIN=$(cd "$(dirname "$BIN")" && pwd)/$(basename "$BIN")
+TMP=$(mktemp -d)
+trap '[ -n "$daemon" ] && kill $daemon 2> /dev/null; rm -rf "$TMP"' EXIT
+cd "$DIR"
+
+failed=0
+checks=0
+
+# Run gtrieScanner, stopping the checks if it fails
+run() {
+  "$BIN" "$@" > "$TMP/log" 2>&1 || { echo "FAILED: gtrieScanner $*"; cat "$TMP/log"; exit 1; }
+}
+
+# Subgraphs found on a results file (see results.awk), sorted
+# (or on snapshot/window $2 of a file written by -st or -tw)
+results() {
+  awk -v block="$2" -f results.awk "$1" | sort
+}
+
+# Compare two files, reporting the check
+same() {
+  checks=$((checks+1))
+  if [ ! -s "$2" ] || ! cmp -s "$2" "$3"; then
+    echo "MISMATCH: $1"
+    diff "$2" "$3" | head -10
+    failed=$((failed+1))
+  fi
+}
+
+# ------------------------------------------------
+# Closed forms: same frequencies as ESU, also on random networks
+
+run -s 3 -m esu    -g dir.txt -d -r 5 -rs 1 -o "$TMP/esu.txt"
+run -s 3 -m triads -g dir.txt -d -r 5 -rs 1 -o "$TMP/triads.txt"
+results "$TMP/esu.txt" > "$TMP/a"; results "$TMP/triads.txt" > "$TMP/b"
+same "triads, directed" "$TMP/a" "$TMP/b"
+
+run -s 3 -m esu    -g undir.txt -r 5 -rs 1 -o "$TMP/esu.txt"
+run -s 3 -m triads -g undir.txt -r 5 -rs 1 -o "$TMP/triads.txt"
+results "$TMP/esu.txt" > "$TMP/a"; results "$TMP/triads.txt" > "$TMP/b"
+same "triads, undirected" "$TMP/a" "$TMP/b"
+
+# Every class is reported, as with -m complete
+run -s 3 -m complete -g dir.txt -d -cd "$TMP" -o "$TMP/complete.txt"
+run -s 3 -m triads   -g dir.txt -d -o "$TMP/triads.txt"
+grep -c "|" "$TMP/complete.txt" > "$TMP/a"; grep -c "|" "$TMP/triads.txt" > "$TMP/b"
+same "triads, all classes" "$TMP/a" "$TMP/b"
+
+# A hub with more open triads than an int holds is an error, not a wrapped count
+awk 'BEGIN {for (i=2; i<=70001; i++) print 1, i, 1}' > "$TMP/hub.txt"
+"$BIN" -s 3 -m triads -g "$TMP/hub.txt" -o "$TMP/triads.txt" > "$TMP/log" 2>&1
+echo $? > "$TMP/b"; grep -c "is larger than" "$TMP/log" >> "$TMP/b"
+printf "1\n1\n" > "$TMP/a"
+same "triads, overflow" "$TMP/a" "$TMP/b"
+
+run -s 4 -m esu       -g undir.txt -r 5 -rs 1 -o "$TMP/esu.txt"
+run -s 4 -m graphlets -g undir.txt -r 5 -rs 1 -o "$TMP/graphlets.txt"
+results "$TMP/esu.txt" > "$TMP/a"; results "$TMP/graphlets.txt" > "$TMP/b"
+same "graphlets" "$TMP/a" "$TMP/b"
+
+# Orbits of each node, counted on the occurrences found by ESU
+# (nodes on no subgraph are left out)
+run -s 4 -m esu       -g undir.txt -oc "$TMP/occ.txt" -o "$TMP/esu.txt"
+run -s 4 -m graphlets -g undir.txt -ob "$TMP/orbits.txt" -o "$TMP/graphlets.txt"
+awk -F'[: ]+' '
+  FILENAME == "undir.txt" { adj[$1, $2] = adj[$2, $1] = 1; next }
+  { e = 0
+    for (i=0; i<4; i++) {
+      d[i] = 0
+      for (j=0; j<4; j++) d[i] += (($(i+2), $(j+2)) in adj)
+      e += d[i]
+    }
+    e /= 2
+    leaves = (d[0]==1) + (d[1]==1) + (d[2]==1) + (d[3]==1)
+    for (i=0; i<4; i++) {
+      if      (e==3 && leaves==2) o = (d[i]==1) ? 0 : 1
+      else if (e==3)              o = (d[i]==1) ? 2 : 3
+      else if (e==4 && leaves==0) o = 4
+      else if (e==4)              o = 4 + d[i]
+      else if (e==5)              o = (d[i]==2) ? 8 : 9
+      else                        o = 10
+      orb[$(i+2), o]++; node[$(i+2)] = 1
+    }
+  }
+  END { for (v in node) {
+          s = v
+          for (o=0; o<=10; o++) s = s " " (orb[v, o] + 0)
+          print s
+        } }' undir.txt "$TMP/occ.txt" | sort > "$TMP/a"
+sed '1,/^Node/d' "$TMP/orbits.txt" | grep -v " 0 0 0 0 0 0 0 0 0 0 0$" | sort > "$TMP/b"
+same "graphlet orbits" "$TMP/a" "$TMP/b"
+
+# Every class is reported, as with -m complete
+run -s 4 -m complete  -g undir.txt -cd "$TMP" -o "$TMP/complete.txt"
+grep -c "|" "$TMP/complete.txt" > "$TMP/a"; grep -c "|" "$TMP/graphlets.txt" > "$TMP/b"
+same "graphlets, all classes" "$TMP/a" "$TMP/b"
+
+awk 'BEGIN {for (i=2; i<=2601; i++) print 1, i, 1}' > "$TMP/hub.txt"
+"$BIN" -s 4 -m graphlets -g "$TMP/hub.txt" -o "$TMP/graphlets.txt" > "$TMP/log" 2>&1
+echo $? > "$TMP/b"; grep -c "is larger than" "$TMP/log" >> "$TMP/b"
+printf "1\n1\n" > "$TMP/a"
+same "graphlets, overflow" "$TMP/a" "$TMP/b"
+
+# ------------------------------------------------
+# Binary g-tries: same g-trie as the ASCII one, both ways, and same census
+
+run -s 4 -m esu -g dir.txt -d -o "$TMP/esu.txt"
+results "$TMP/esu.txt" > "$TMP/a"
+cut -d' ' -f1 "$TMP/a" > "$TMP/dir4.str"
+run -s 4 -d -c "$TMP/dir4.str" -o "$TMP/dir4.gt"
+run -s 4 -d -bi -c "$TMP/dir4.str" -o "$TMP/dir4.gtb"
+run -cv "$TMP/dir4.gt" -o "$TMP/converted.gtb"
+run -cv "$TMP/dir4.gtb" -o "$TMP/converted.gt"
+same "binary g-trie, from ASCII" "$TMP/dir4.gtb" "$TMP/converted.gtb"
+same "binary g-trie, to ASCII" "$TMP/dir4.gt" "$TMP/converted.gt"
+
+run -s 4 -m gtrie "$TMP/dir4.gtb" -g dir.txt -d -o "$TMP/binary.txt"
+results "$TMP/binary.txt" > "$TMP/b"
+same "binary g-trie, census" "$TMP/a" "$TMP/b"
+
+# ------------------------------------------------
+# Processes (-j): the g-tries created or generated are the same
+
+run -s 4 -d -c "$TMP/dir4.str" -j 3 -o "$TMP/jobs.gt"
+same "created g-trie, 3 processes" "$TMP/dir4.gt" "$TMP/jobs.gt"
+mkdir -p "$TMP/cache1" "$TMP/cache3"
+run -s 4 -m complete -g dir.txt -d -cd "$TMP/cache1" -o "$TMP/complete.txt"
+run -s 4 -m complete -g dir.txt -d -cd "$TMP/cache3" -j 3 -o "$TMP/complete.txt"
+for f in "$TMP"/cache1/*; do
+  same "complete g-trie, 3 processes" "$f" "$TMP/cache3/$(basename "$f")"
+done
+
+# ------------------------------------------------
+# G-tries generated or sampled: a complete g-trie, or one with the
+# subgraphs found on a sample of all of them, finds the same as ESU
+
+run -s 4 -m esu      -g dir.txt -d -r 5 -rs 1 -o "$TMP/esu.txt"
+run -s 4 -m complete -g dir.txt -d -r 5 -rs 1 -cd "$TMP" -o "$TMP/complete.txt"
+run -s 4 -m hybrid   -g dir.txt -d -r 5 -rs 1 -hs 1 -o "$TMP/hybrid.txt"
+results "$TMP/esu.txt" > "$TMP/a"
+results "$TMP/complete.txt" > "$TMP/b"
+same "complete g-trie" "$TMP/a" "$TMP/b"
+results "$TMP/hybrid.txt" > "$TMP/b"
+same "hybrid, whole sample" "$TMP/a" "$TMP/b"
+
+# A sample with no subgraphs (the network has none) is not an error
+echo "1 2 1" > "$TMP/edge.txt"
+run -s 3 -m hybrid -g "$TMP/edge.txt" -r 2 -rs 1 -o "$TMP/hybrid.txt"
+echo $(results "$TMP/hybrid.txt" | wc -l) > "$TMP/b"
+echo 0 > "$TMP/a"
+same "hybrid, empty sample" "$TMP/a" "$TMP/b"
+
+# ------------------------------------------------
+# Intersected candidates (-ix), with every set operation kernel the
+# CPU has, find the same subgraphs as the plain scan
+
+for net in "undir.txt" "dir.txt -d"; do
+  run -s 4 -m esu -g $net -o "$TMP/esu.txt"
+  results "$TMP/esu.txt" > "$TMP/a"
+  for kernel in scalar sse avx2; do
+    "$BIN" -s 4 -so $kernel -g $net -o "$TMP/ix.txt" 2>&1 | grep -q "not supported by this CPU" && continue
+    run -s 4 -m complete -g $net -cd "$TMP" -ix -so $kernel -o "$TMP/ix.txt"
+    results "$TMP/ix.txt" > "$TMP/b"
+    same "intersection, $kernel, $net" "$TMP/a" "$TMP/b"
+  done
+done
+
+# ------------------------------------------------
+# Checkpoints: a census resumed from the middle of its checkpoint file
+# (as if interrupted there) ends with the results of an uninterrupted one
+
+rm -f "$TMP/checkpoint"
+run -s 4 -m gtrie "$TMP/dir4.gt" -g dir.txt -d -r 2 -rs 1 -cp "$TMP/checkpoint" -ci 0 -o "$TMP/whole.txt"
+truncate -s $(($(wc -c < "$TMP/checkpoint") / 2)) "$TMP/checkpoint"
+run -s 4 -m gtrie "$TMP/dir4.gt" -g dir.txt -d -r 2 -rs 1 -cp "$TMP/checkpoint" -ci 0 -cr -o "$TMP/resumed.txt"
+results "$TMP/whole.txt" > "$TMP/a"; results "$TMP/resumed.txt" > "$TMP/b"
+same "checkpoint, resumed" "$TMP/a" "$TMP/b"
+
+# ------------------------------------------------
+# Node orders: renumbering the nodes does not change the results
+
+run -s 4 -m esu -g dir.txt -d -o "$TMP/esu.txt"
+results "$TMP/esu.txt" > "$TMP/a"
+for order in degree degree_desc degeneracy bfs rcm; do
+  run -s 4 -m gtrie "$TMP/dir4.gt" -g dir.txt -d -or $order -o "$TMP/order.txt"
+  results "$TMP/order.txt" > "$TMP/b"
+  same "order $order" "$TMP/a" "$TMP/b"
+done
+
+# ------------------------------------------------
+# Seeds: the occurrences dumped by -oc that have one of the seeds
+
+printf "3\n17\n" > "$TMP/seeds.txt"
+run -s 4 -m esu -g dir.txt -d -oc "$TMP/occ.txt" -o "$TMP/esu.txt"
+awk '{for (i=2; i<=NF; i++) if ($i == 3 || $i == 17) {print; break}}' "$TMP/occ.txt" |
+  awk -v occ=1 -f results.awk | sort > "$TMP/a"
+for method in esu "gtrie $TMP/dir4.gt"; do
+  run -s 4 -m $method -g dir.txt -d -sd "$TMP/seeds.txt" -o "$TMP/seeds.out"
+  results "$TMP/seeds.out" | cut -d' ' -f1,2 > "$TMP/b"
+  same "seeds, ${method%% *}" "$TMP/a" "$TMP/b"
+done
+
+# ------------------------------------------------
+# Node labels that are not integers: same results, and the occurrences
+# (sets of nodes) have the labels of the file
+
+awk '{print "n" $1, "n" $2, $3}' dir.txt > "$TMP/names.txt"
+run -s 4 -m esu -g dir.txt -d -oc "$TMP/occ.txt" -o "$TMP/esu.txt"
+run -s 4 -m esu -g "$TMP/names.txt" -d -oc "$TMP/names.occ" -o "$TMP/names.out"
+results "$TMP/esu.txt" > "$TMP/a"; results "$TMP/names.out" > "$TMP/b"
+same "labels, results" "$TMP/a" "$TMP/b"
+nodesets() {
+  tr -d n < "$1" | awk '{
+    for (i=2; i<=NF; i++)
+      for (j=i; j>2 && $(j-1)+0 > $j+0; j--) { t = $j; $j = $(j-1); $(j-1) = t }
+    $1 = ""; print }' | sort
+}
+nodesets "$TMP/occ.txt" > "$TMP/a"; nodesets "$TMP/names.occ" > "$TMP/b"
+same "labels, occurrences" "$TMP/a" "$TMP/b"
+
+# ------------------------------------------------
+# Partitions: the merged results of all partitions are those of a single
+# census, on the random networks too
+
+for method in esu "gtrie $TMP/dir4.gt"; do
+  run -s 4 -m $method -g dir.txt -d -r 3 -rs 5 -o "$TMP/whole.txt"
+  for i in 0 1 2; do
+    run -s 4 -m $method -g dir.txt -d -r 3 -rs 5 -pa $i/3 -o "$TMP/part$i.part"
+  done
+  run -mg "$TMP/part0.part" "$TMP/part1.part" "$TMP/part2.part" -o "$TMP/merged.txt"
+  results "$TMP/whole.txt" > "$TMP/a"; results "$TMP/merged.txt" > "$TMP/b"
+  same "partitions, ${method%% *}" "$TMP/a" "$TMP/b"
+done
+
+# ------------------------------------------------
+# Estimates: the same for any number of processes, and only of
+# subgraphs that ESU finds
+
+# Subgraphs (canonical) of the estimates written on file $1
+estimated() {
+  awk '/^[01]+ / {print $1 ":"}' "$1" | awk -v occ=1 -f results.awk | cut -d' ' -f1 | sort
+}
+
+run -s 4 -m esu -g undir.txt -o "$TMP/esu.txt"
+results "$TMP/esu.txt" | cut -d' ' -f1 | sort > "$TMP/found.txt"
+run -s 4 -m colorcoding -g undir.txt -cn 10 -cs 5000 -rs 1 -o "$TMP/one.txt"
+run -s 4 -m colorcoding -g undir.txt -cn 10 -cs 5000 -rs 1 -j 3 -o "$TMP/three.txt"
+grep -v "^Time" "$TMP/one.txt" > "$TMP/a"; grep -v "^Time" "$TMP/three.txt" > "$TMP/b"
+same "color coding, 3 processes" "$TMP/a" "$TMP/b"
+estimated "$TMP/one.txt" > "$TMP/a"
+comm -12 "$TMP/a" "$TMP/found.txt" > "$TMP/b"
+same "color coding, subgraphs" "$TMP/a" "$TMP/b"
+
+run -s 4 -m esu -g dir.txt -d -o "$TMP/esu.txt"
+results "$TMP/esu.txt" | cut -d' ' -f1 | sort > "$TMP/found.txt"
+run -s 4 -m randomwalk -g dir.txt -d -wn 4 -ws 5000 -rs 1 -o "$TMP/one.txt"
+run -s 4 -m randomwalk -g dir.txt -d -wn 4 -ws 5000 -rs 1 -j 3 -o "$TMP/three.txt"
+grep -v "^Time" "$TMP/one.txt" > "$TMP/a"; grep -v "^Time" "$TMP/three.txt" > "$TMP/b"
+same "random walk, 3 processes" "$TMP/a" "$TMP/b"
+estimated "$TMP/one.txt" > "$TMP/a"
+comm -12 "$TMP/a" "$TMP/found.txt" > "$TMP/b"
+same "random walk, subgraphs" "$TMP/a" "$TMP/b"
+
+# ------------------------------------------------
+# Delta census: the random networks keep the frequencies of a census
+
+run -s 4 -m esu -g undir.txt -r 5 -rs 3 -o "$TMP/esu.txt"
+run -s 4 -m esu -g undir.txt -r 5 -rs 3 -dc -o "$TMP/delta.txt"
+results "$TMP/esu.txt" > "$TMP/a"; results "$TMP/delta.txt" > "$TMP/b"
+same "delta census, undirected" "$TMP/a" "$TMP/b"
+
+run -s 4 -m esu -g dir.txt -d -r 5 -rs 3 -o "$TMP/esu.txt"
+run -s 4 -m esu -g dir.txt -d -r 5 -rs 3 -dc -o "$TMP/delta.txt"
+results "$TMP/esu.txt" > "$TMP/a"; results "$TMP/delta.txt" > "$TMP/b"
+same "delta census, directed" "$TMP/a" "$TMP/b"
+
+# ------------------------------------------------
+# Streams: after each batch of updates, the frequencies of a census of
+# the network with those updates
+
+# Network $1 after the first $2 updates of file $3 ('-d' as $4 if directed)
+updated() {
+  awk -v n="$2" -v dir="$4" '
+    function key(a, b) { return (dir == "" && a+0 > b+0) ? b " " a : a " " b }
+    FILENAME != upd { edge[key($1, $2)] = 1; next }
+    FNR <= n        { if ($1 == "+") edge[key($2, $3)] = 1; else delete edge[key($2, $3)] }
+    END             { for (e in edge) print e, 1 }' upd="$3" "$1" "$3"
+}
+
+awk 'NR<=15         {print "-", $1, $2}
+     NR>15 && NR<=30 {print "+", $1, $1%40+2}
+     END             {print "+ 41 1"}' undir.txt > "$TMP/updates.txt"
+run -s 4 -m esu -g undir.txt -st "$TMP/updates.txt" -sb 10 -o "$TMP/stream.txt"
+for i in 1 3 4; do
+  updated undir.txt $((i*10)) "$TMP/updates.txt" > "$TMP/updated.txt"
+  run -s 4 -m esu -g "$TMP/updated.txt" -o "$TMP/esu.txt"
+  results "$TMP/esu.txt" | cut -d' ' -f1,2 > "$TMP/a"
+  results "$TMP/stream.txt" $i > "$TMP/b"
+  same "stream, snapshot $i" "$TMP/a" "$TMP/b"
+done
+
+awk 'NR%3==0 {print "-", $1, $2} NR%3==1 {print "+", $2, $1}' dir.txt > "$TMP/updates.txt"
+run -s 3 -m esu -g dir.txt -d -st "$TMP/updates.txt" -sb 20 -o "$TMP/stream.txt"
+updated dir.txt 1000 "$TMP/updates.txt" -d > "$TMP/updated.txt"
+run -s 3 -m esu -g "$TMP/updated.txt" -d -o "$TMP/esu.txt"
+results "$TMP/esu.txt" | cut -d' ' -f1,2 > "$TMP/a"
+results "$TMP/stream.txt" 4 > "$TMP/b"
+same "stream, directed" "$TMP/a" "$TMP/b"
+
+# ------------------------------------------------
+# Temporal mode: each window has the frequencies of a census of the
+# edges with a time inside it (timed.txt has some edges more than once)
+
+run -s 4 -g timed.txt -tw 30 -tt 15 -o "$TMP/windows.txt"
+while read w i start end rest; do
+  i=${i%:}
+  awk -v s=$start -v e=$end '$3 >= s && $3 < e {
+         if ($1+0 > $2+0) print $2, $1, 1; else print $1, $2, 1 }' timed.txt | sort -u > "$TMP/window.txt"
+  run -s 4 -m esu -g "$TMP/window.txt" -o "$TMP/esu.txt"
+  results "$TMP/esu.txt" | cut -d' ' -f1,2 > "$TMP/a"
+  results "$TMP/windows.txt" $i > "$TMP/b"
+  same "temporal, window $i" "$TMP/a" "$TMP/b"
+done < <(grep "^Window [0-9]" "$TMP/windows.txt" | tr -d '[,)')
+
+# ------------------------------------------------
+# Occurrence index: the queries give the occurrences dumped by -oc
+
+for net in "undir.txt" "dir.txt -d"; do
+  run -s 4 -m esu -g $net -oc "$TMP/occ.txt" -oi "$TMP/index.oci" -o "$TMP/esu.txt"
+  run -q "$TMP/index.oci" -o "$TMP/list.txt"
+  cut -d: -f1 "$TMP/occ.txt" | sort | uniq -c | awk '{print $2 ":", $1, "occurrences"}' > "$TMP/a"
+  grep "^[01]*:" "$TMP/list.txt" | cut -d, -f1 | sort > "$TMP/b"
+  same "occurrence index, classes of $net" "$TMP/a" "$TMP/b"
+
+  rm -f "$TMP/a" "$TMP/b"
+  for class in $(cut -d' ' -f1 "$TMP/list.txt" | grep "^[01]*:" | tr -d :); do
+    for node in 1 7 20; do
+      grep "^$class:" "$TMP/occ.txt" | awk -v n=$node '{for (i=2; i<=NF; i++) if ($i == n) print}' | sort >> "$TMP/a"
+      run -q "$TMP/index.oci" -qc $class -qn $node -o "$TMP/query.txt"
+      sort "$TMP/query.txt" >> "$TMP/b"
+    done
+  done
+  same "occurrence index, queries on $net" "$TMP/a" "$TMP/b"
+
+  grep "^$class:" "$TMP/occ.txt" | sort > "$TMP/a"
+  run -q "$TMP/index.oci" -qc $class -o "$TMP/query.txt"
+  sort "$TMP/query.txt" > "$TMP/b"
+  same "occurrence index, one class of $net" "$TMP/a" "$TMP/b"
+
+  awk '{for (i=2; i<=NF; i++) if ($i == 7) print}' "$TMP/occ.txt" | sort > "$TMP/a"
+  run -q "$TMP/index.oci" -qn 7 -o "$TMP/query.txt"
+  sort "$TMP/query.txt" > "$TMP/b"
+  same "occurrence index, one node of $net" "$TMP/a" "$TMP/b"
+done
+
+# ------------------------------------------------
+# Daemon: requests give the results of a direct run (also the second
+# time, with the graph and g-trie in memory) and report failures
+
+"$BIN" -dm "$TMP/daemon.sock" -dw 2 > "$TMP/daemon.log" 2>&1 &
+daemon=$!
+for i in $(seq 50); do [ -S "$TMP/daemon.sock" ] && break; sleep 0.1; done
+run -s 4 -m gtrie "$TMP/dir4.gt" -g dir.txt -d -o "$TMP/direct.txt"
+results "$TMP/direct.txt" > "$TMP/a"
+for i in 1 2; do
+  run -cl "$TMP/daemon.sock" -s 4 -m gtrie "$TMP/dir4.gt" -g dir.txt -d -o "$TMP/daemon.txt"
+  results "$TMP/daemon.txt" > "$TMP/b"
+  same "daemon, request $i" "$TMP/a" "$TMP/b"
+done
+"$BIN" -cl "$TMP/daemon.sock" -s 4 -m esu -g missing.txt -o "$TMP/daemon.txt" > /dev/null 2>&1
+echo $? > "$TMP/b"
+echo 1 > "$TMP/a"
+same "daemon, failed request" "$TMP/a" "$TMP/b"
+kill $daemon
+wait $daemon 2> /dev/null
+
+# ------------------------------------------------
+# Library (tests/library.cpp, built by 'make check'): a census on two
+# threads finds the same as ESU
+
+if [ -x library ]; then
+  for net in "undir.txt" "dir.txt -d"; do
+    run -s 4 -m esu -g $net -o "$TMP/esu.txt"
+    results "$TMP/esu.txt" | cut -d' ' -f1,2 > "$TMP/a"
+    ./library 4 $net > "$TMP/library.txt" || { echo "FAILED: library $net"; exit 1; }
+    awk -v pairs=1 -f results.awk "$TMP/library.txt" | sort > "$TMP/b"
+    same "library, $net" "$TMP/a" "$TMP/b"
+  done
+fi
+
+# ------------------------------------------------
+
+echo "$checks checks, $failed failed"
+[ $failed -eq 0 ]
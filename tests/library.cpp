@@ -0,0 +1,75 @@
+/* -------------------------------------------------
+      _       _     ___                            
+ __ _| |_ _ _(_)___/ __| __ __ _ _ _  _ _  ___ _ _ 
+/ _` |  _| '_| / -_)__ \/ _/ _` | ' \| ' \/ -_) '_|
+\__, |\__|_| |_\___|___/\__\__,_|_||_|_||_\___|_|  
+|___/                                          
+    
+gtrieScanner: quick discovery of network motifs
+Released under Artistic License 2.0
+(see README and LICENSE)
+
+Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+
+----------------------------------------------------
+Library check: census with libgtrie on two threads
+
+Last Update: 19/10/2026
+---------------------------------------------------- */
+
+#include "Census.h"
+#include "Error.h"
+#include <thread>
+
+// Census of the subgraphs of size argv[1] of graph argv[2] (directed with
+// "-d" as argv[3]) with a complete g-trie, on two threads at the same time.
+// Writes the frequencies found ("adjacency frequency", one per line) if
+// both threads agree and a missing graph throws an error
+int main(int argc, char **argv) {
+  int i, size;
+  bool dir;
+  GTrie *t[2];
+  CensusResult r[2];
+  std::thread th[2];
+  mapStringInt::const_iterator ii;
+
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <size> <graph> [-d]\n", argv[0]);
+    return 2;
+  }
+  size = atoi(argv[1]);
+  dir  = (argc > 3 && !strcmp(argv[3], "-d"));
+
+  try {
+    Census::readGraph("missing.txt", dir, true);
+    fprintf(stderr, "No error reading a missing graph\n");
+    return 1;
+  } catch (ErrorException &e) {}
+
+  try {
+    Graph *g = Census::readGraph(argv[2], dir, true);
+    for (i=0; i<2; i++)
+      t[i] = Census::buildComplete(size, dir);
+    for (i=0; i<2; i++)
+      th[i] = std::thread(Census::run, g, t[i], (const CensusOptions *)NULL, &r[i]);
+    for (i=0; i<2; i++)
+      th[i].join();
+
+    if (r[0].freq != r[1].freq) {
+      fprintf(stderr, "Threads found different frequencies\n");
+      return 1;
+    }
+    for (ii=r[0].freq.begin(); ii!=r[0].freq.end(); ii++)
+      if (ii->second > 0)
+	printf("%s %d\n", ii->first.c_str(), ii->second);
+
+    for (i=0; i<2; i++)
+      delete t[i];
+    delete g;
+  } catch (ErrorException &e) {
+    fprintf(stderr, "Error: %s\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
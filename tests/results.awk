@@ -0,0 +1,51 @@
+# gtrieScanner: quick discovery of network motifs
+#
+# Pedro Ribeiro - CRACS & INESC-TEC, DCC/FCUP
+# ------------------------------------------------
+# Subgraphs found on a results file, one per line: adjacency matrix,
+# frequency and (with random networks) their average and deviation.
+# Methods may write a class with different adjacency matrices, so each
+# one is replaced by the smallest over all the permutations of its nodes.
+# With -v block=N, the frequencies of snapshot (-st) or window (-tw) N.
+# With -v occ=1, the number of occurrences on a file of occurrences (-oc).
+# With -v pairs=1, lines with just an adjacency matrix and a frequency.
+# ------------------------------------------------
+
+pairs != "" {print canon($1), $2; next}
+
+occ != ""   {sub(":", "", $1); if (!($1 in form)) form[$1] = canon($1); n[form[$1]]++; next}
+END         {for (c in n) print c, n[c]}
+
+block != "" && /^(Snapshot|Window) / {on = ($2 == block ":"); next}
+block != ""                          {if (on && NF==2) print canon($1), $2; next}
+
+/Org_Freq/  {on=1; next}
+on && NF==0 {adj=""; next}
+on && NF==1 {adj=adj $1; next}
+on && $2>0  {print canon(adj $1), $2, $6, $8; adj=""}
+
+# Smallest adjacency matrix (as a string of n*n characters) over all
+# the permutations of the nodes of 'adj'
+
+function canon(adj,    n, i, j, k, c, t, p, best, s) {
+  n = int(sqrt(length(adj)) + 0.5);
+  for (i=0; i<n; i++) { p[i] = i; c[i] = 0; }
+  best = adj;
+  # Heap's algorithm: every permutation p of the nodes
+  for (i=0; i<n; ) {
+    if (c[i] < i) {
+      k = (i%2 == 0) ? 0 : c[i];
+      t = p[k]; p[k] = p[i]; p[i] = t;
+      s = "";
+      for (j=0; j<n*n; j++)
+        s = s substr(adj, p[int(j/n)]*n + p[j%n] + 1, 1);
+      if (s < best) best = s;
+      c[i]++;
+      i = 0;
+    } else {
+      c[i] = 0;
+      i++;
+    }
+  }
+  return best;
+}